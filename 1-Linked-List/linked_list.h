@@ -7,11 +7,16 @@ struct linked_list;
 struct node;
 typedef double value_t;
 
+/**
+ * first and last are the physical ends of the node chain. When reversed is set, the list is read from last to first:
+ *  its front is last, its back is first, and iterators advance through prev instead of next.
+ */
 typedef struct linked_list
 {
 	struct node* first;
 	struct node* last;
 	size_t size;
+	bool reversed;
 } linked_list;
 
 typedef struct node
@@ -25,9 +30,13 @@ typedef bool (*comparator_t)(const value_t*, const value_t*);
 typedef void (*callback_t)(const value_t*);
 typedef node* iter_t;
 typedef const node* const_iter_t;
+typedef struct reverse_iter_t
+{
+	node* n;
+} reverse_iter_t;
 
 /**
- * Initializes a linked_list object.
+ * Initializes a linked_list object, in forward orientation.
  */
 void linked_list_init(linked_list* list);
 
@@ -98,7 +107,7 @@ value_t linked_list_get(const linked_list* list, size_t idx);
 value_t linked_list_set(linked_list* list, size_t idx, value_t newValue);
 
 /**
- * Reverses the elements of a linked_list.
+ * Reverses the elements of a linked_list in O(1) by toggling its orientation, no node is written.
  */
 void linked_list_reverse(linked_list* list);
 
@@ -110,6 +119,8 @@ void linked_list_sort(linked_list* list, comparator_t comparator);
 /**
 * Appends one linked_list to the end of another. The source list should be an empty list.
 * The source linked_list should become an empty linked list.
+* If the orientations of the lists differ, the nodes of the source are relinked to the destination's orientation in a
+* single pass.
 */
 void linked_list_append(linked_list* dest, linked_list* src);
 
@@ -119,7 +130,7 @@ void linked_list_append(linked_list* dest, linked_list* src);
 void linked_list_foreach(const linked_list* list, callback_t callback);
 
 /**
- * Swaps the elements of two linked_lists.
+ * Swaps the elements (and orientations) of two linked_lists.
  */
 void linked_list_swap(linked_list* list1, linked_list* link2);
 
@@ -202,6 +213,8 @@ void linked_list_swap_nodes(linked_list* list, iter_t iter1, iter_t iter2);
 
 /**
  * Reverses the nodes of a linked_list by their elements from [first, last).
+ * The range is relinked in a single pass, writing each node once. A range spanning the whole list only toggles the
+ * orientation, as linked_list_reverse does.
  * Assume dist(first, last) is non-negative and first != end.
  */
 void linked_list_reverse_nodes(linked_list* list, iter_t first, iter_t last);
@@ -211,3 +224,40 @@ void linked_list_reverse_nodes(linked_list* list, iter_t first, iter_t last);
  * Assume dist(first, last) is non-negative, and and first != end.
  */
 void linked_list_sort_nodes(linked_list* list, iter_t first, iter_t last, comparator_t comparator);
+
+/**
+ * Returns a reverse iterator to the last element of a linked_list, the first element of its reversed view.
+ * If the list is empty, the reverse end iterator is returned.
+ * A reverse iterator is a distinct type from iter_t: use linked_list_rread, linked_list_rwrite and
+ * linked_list_riter_equal with it, its n member is the node of its element.
+ */
+reverse_iter_t linked_list_rbegin(linked_list* list);
+
+/**
+ * Returns a reverse iterator to one before the first element of a linked_list.
+ */
+reverse_iter_t linked_list_rend(linked_list* list);
+
+/**
+ * Advances a reverse iterator by a number of steps towards the front of a linked_list, a negative step indicates
+ * advancing towards the back.
+ * Assume iter + steps will be in the range [rbegin, rend].
+ */
+reverse_iter_t linked_list_radvance(linked_list* list, reverse_iter_t iter, ptrdiff_t steps);
+
+/**
+ * Returns whether two reverse iterators refer to the same position.
+ */
+bool linked_list_riter_equal(reverse_iter_t iter1, reverse_iter_t iter2);
+
+/**
+ * Returns the element associated with a reverse iterator.
+ * Assume iter is in the range [rbegin, rend).
+ */
+value_t linked_list_rread(const linked_list* list, reverse_iter_t iter);
+
+/**
+ * Alters the element associated with a reverse iterator and returns the old value.
+ * Assume iter is in the range [rbegin, rend).
+ */
+value_t linked_list_rwrite(linked_list* list, reverse_iter_t iter, value_t value);
@@ -36,6 +36,7 @@ static void test_required_interface(size_t* const success, size_t* const total);
 static void test_extra_functionality(size_t* const success, size_t* const total);
 static void test_iterator_interface(size_t* const success, size_t* const total);
 static void test_extra_iterator_functionality(size_t* const success, size_t* const total);
+static void test_lazy_reversal(size_t* const success, size_t* const total);
 
 static void print_array(const value_t* arr, size_t size);
 static void print_list(const linked_list* list);
@@ -67,6 +68,10 @@ int main(void)
 		RUN_TESTS("Extra Iterator Functionality", test_extra_iterator_functionality);
 	#endif
 
+	#ifdef TEST_LAZY_REVERSAL
+		RUN_TESTS("Lazy Reversal", test_lazy_reversal);
+	#endif
+
 	printf("All tests completed, summary: %lu/%lu tests passed.\n", totalSuccess, totalTotal);
 
 	return 0;
@@ -696,6 +701,129 @@ void test_extra_iterator_functionality(size_t* const success, size_t* const tota
 	linked_list_clear(list);
 }
 
+void test_lazy_reversal(size_t* const success, size_t* const total)
+{
+	linked_list _list;
+	linked_list* list = &_list;
+	linked_list _other;
+	linked_list* other = &_other;
+
+	linked_list_init(list);
+	linked_list_init(other);
+
+	for (size_t idx = 1; idx <= 10; idx++)
+		linked_list_push_back(list, (value_t)idx);
+
+	// 1 2 3 4 5 6 7 8 9 10
+	PRINT_LIST(list, "list: ");
+
+	{
+		node* first = list->first;
+		node* second = first->next;
+
+		// 10 9 8 7 6 5 4 3 2 1
+		linked_list_reverse(list);
+		PRINT_LIST(list, "list: ");
+		TEST(list->first == first && first->next == second, "reverse relinked nodes");
+		TEST(linked_list_front(list) == 10.0, "value at front is NOT 10.0");
+		TEST(linked_list_back(list) == 1.0, "value at back is NOT 1.0");
+		TEST(linked_list_get(list, 2) == 8.0, "value at index 2 is NOT 8.0");
+		TEST(linked_list_read(list, linked_list_begin(list)) == 10.0, "value at begin is NOT 10.0");
+		TEST(linked_list_read(list, linked_list_advance(list,
+			linked_list_begin(list), 3)) == 7.0, "value at begin + 3 is NOT 7.0");
+		TEST(linked_list_advance(list, linked_list_begin(list), 10) == linked_list_end(list),
+			"begin + 10 is NOT end");
+		TEST(linked_list_read(list, linked_list_advance(list,
+			linked_list_end(list), -1)) == 1.0, "value at end - 1 is NOT 1.0");
+	}
+
+	{
+		// 0 10 9 8 7 6 5 4 3 2 1 11
+		linked_list_push_front(list, 0.0);
+		linked_list_push_back(list, 11.0);
+		PRINT_LIST(list, "list: ");
+		TEST(linked_list_size(list) == 12, "list size is NOT 12");
+		TEST(linked_list_front(list) == 0.0, "value at front is NOT 0.0");
+		TEST(linked_list_back(list) == 11.0, "value at back is NOT 11.0");
+		TEST(linked_list_get(list, 1) == 10.0, "value at index 1 is NOT 10.0");
+
+		// 10 9 8 7 6 5 4 3 2 1
+		TEST(linked_list_pop_front(list) == 0.0, "popped front is NOT 0.0");
+		TEST(linked_list_pop_back(list) == 11.0, "popped back is NOT 11.0");
+		PRINT_LIST(list, "list: ");
+
+		// 10 9 8 7 5 4 3 2 1
+		linked_list_erase(list, linked_list_advance(list, linked_list_begin(list), 4));
+		PRINT_LIST(list, "list: ");
+		TEST(linked_list_get(list, 4) == 5.0, "value at index 4 is NOT 5.0");
+
+		// 10 9 8 7 6 5 4 3 2 1
+		linked_list_insert(list, linked_list_advance(list, linked_list_begin(list), 4), 6.0);
+		PRINT_LIST(list, "list: ");
+		TEST(linked_list_get(list, 4) == 6.0, "value at index 4 is NOT 6.0");
+		TEST(linked_list_get(list, 5) == 5.0, "value at index 5 is NOT 5.0");
+	}
+
+	{
+		bool allEqual = true;
+		size_t idx = 0;
+
+		// reversed view of 10 9 8 7 6 5 4 3 2 1 is 1 2 3 4 5 6 7 8 9 10
+		for (reverse_iter_t iter = linked_list_rbegin(list); !linked_list_riter_equal(iter, linked_list_rend(list));
+			iter = linked_list_radvance(list, iter, 1))
+			if (linked_list_rread(list, iter) != (value_t)++idx)
+				allEqual = false;
+
+		TEST(allEqual && idx == 10, "reversed view is NOT 1 ... 10");
+		TEST(linked_list_rread(list, linked_list_radvance(list,
+			linked_list_rend(list), -1)) == 10.0, "value at rend - 1 is NOT 10.0");
+
+		// 1 2 3 4 5 6 7 8 9 10
+		linked_list_reverse(list);
+		TEST(linked_list_rread(list, linked_list_rbegin(list)) == 10.0, "value at rbegin is NOT 10.0");
+		TEST(linked_list_rbegin(list).n == linked_list_advance(list,
+			linked_list_end(list), -1), "rbegin is NOT end - 1");
+	}
+
+	{
+		// 1 2 3 4 5 6 7 8 9 10 30 20
+		linked_list_push_back(other, 20.0);
+		linked_list_push_back(other, 30.0);
+		linked_list_reverse(other);
+		linked_list_append(list, other);
+		PRINT_LIST(list, "list: ");
+		TEST(linked_list_size(list) == 12, "list size is NOT 12");
+		TEST(linked_list_size(other) == 0, "other size is NOT 0");
+		TEST(linked_list_get(list, 10) == 30.0, "value at index 10 is NOT 30.0");
+		TEST(linked_list_back(list) == 20.0, "value at back is NOT 20.0");
+
+		// 1 2 7 6 5 4 3 8 9 10 30 20
+		linked_list_reverse_nodes(list, linked_list_advance(list, linked_list_begin(list), 2),
+			linked_list_advance(list, linked_list_begin(list), 7));
+		PRINT_LIST(list, "list: ");
+		TEST(linked_list_get(list, 1) == 2.0, "value at index 1 is NOT 2.0");
+		TEST(linked_list_get(list, 2) == 7.0, "value at index 2 is NOT 7.0");
+		TEST(linked_list_get(list, 6) == 3.0, "value at index 6 is NOT 3.0");
+		TEST(linked_list_get(list, 7) == 8.0, "value at index 7 is NOT 8.0");
+
+		// 20 30 10 9 8 3 4 5 6 7 2 1
+		linked_list_reverse_nodes(list, linked_list_begin(list), linked_list_end(list));
+		PRINT_LIST(list, "list: ");
+		TEST(linked_list_front(list) == 20.0, "value at front is NOT 20.0");
+		TEST(linked_list_get(list, 5) == 3.0, "value at index 5 is NOT 3.0");
+		TEST(linked_list_back(list) == 1.0, "value at back is NOT 1.0");
+
+		// swapping exchanges orientations with the elements
+		linked_list_swap(list, other);
+		TEST(linked_list_size(list) == 0, "list size after swap is NOT 0");
+		TEST(linked_list_front(other) == 20.0, "value at other front is NOT 20.0");
+		TEST(linked_list_back(other) == 1.0, "value at other back is NOT 1.0");
+	}
+
+	linked_list_clear(list);
+	linked_list_clear(other);
+}
+
 void print_array(const value_t* arr, size_t size)
 {
 	for (size_t idx = 0; idx < size; idx++)
@@ -708,7 +836,8 @@ void print_list(const linked_list* list)
 	node* iter;
 	size_t idx;
 
-	for (iter = list->first, idx = 0; idx < list->size && iter != NULL; idx++, iter = iter->next)
+	for (iter = list->reversed ? list->last : list->first, idx = 0; idx < list->size && iter != NULL;
+		idx++, iter = list->reversed ? iter->prev : iter->next)
 		PRINT_VAL(iter->value);
 	printf("\n");
 }
@@ -0,0 +1,23 @@
+#include <math.h>
+#include <stdlib.h>
+#include "aggregate.h"
+
+/* Aggregation interface implementation */
+
+int aggregate_init(aggregate_t* aggregate, size_t expected_groups, size_t cache_bytes, const table_config_t* config);
+
+void aggregate_free(aggregate_t* aggregate);
+
+void aggregate_clear(aggregate_t* aggregate);
+
+int aggregate_add(aggregate_t* aggregate, const aggregate_row_t* rows, size_t n);
+
+int aggregate_finish(aggregate_t* aggregate);
+
+size_t aggregate_groups(const aggregate_t* aggregate);
+
+const aggregate_state_t* aggregate_find(const aggregate_t* aggregate, const table_key_t* key);
+
+const aggregate_state_t* aggregate_begin(const aggregate_t* aggregate);
+
+const aggregate_state_t* aggregate_next(const aggregate_t* aggregate, const aggregate_state_t* state);
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <stddef.h>
+#include "table.h"
+
+/**
+ * The aggregate_t type implements a hash group-by operator computing the count, sum, minimum, and maximum of the
+ *  values of (key, double) rows per key.
+ *
+ * Implementation-defined specification:
+ *   aggregate_t: Aggregation structure type definition.
+ *
+ * Expectations:
+ *   Groups are indexed by table_t. Every state table is a table_t mapping a key (inserted TRANSIENT) to the position of
+ *    its group state (aggregate_state_t) in a contiguous state array kept beside it, since a table_value_t cannot
+ *    hold a state. There is no allocation per group or per row beyond the growth of the tables and state arrays. The
+ *    positions are table_value_t, so table_value_t must be an integer type (int in table.h, allowing INT_MAX groups
+ *    per state table).
+ *   aggregate_add processes rows in batches of AGGREGATE_BATCH: the keys of a batch are looked up together with
+ *    table_find_batch (hashing the whole batch and prefetching its slots), and the state position of every hit is read
+ *    from its iterator right away, before any miss is inserted, since an insertion may grow the table and invalidate
+ *    the batch's iterators. The keys it missed are then inserted with table_find_or_insert, each yielding its position
+ *    at once, and only then are the states updated through the recorded positions, so the cache misses of a batch
+ *    overlap. Rows repeating a key within a batch are applied in order.
+ *   When the expected number of groups would not fit the cache budget, rows are first scattered by the high bits of
+ *    their hash (the radix) into 2^k partition buffers, k chosen so each partition's table and states fit the budget,
+ *    and each partition buffer is aggregated into its own state table when it fills and on aggregate_finish. The number
+ *    of partitions is fixed at initialization, so a poor estimate only costs speed. A partition's buffer, state table,
+ *    and state array are only allocated when its first row arrives, and its state table is then pre-sized for its
+ *    share of the expected groups (expected_groups / 2^k), so initialization allocates no more than the partition
+ *    directory whatever the estimate.
+ *   Sums are accumulated in row order in double precision. Minimum and maximum follow fmin and fmax: NaN values are
+ *    ignored unless every value of a group is NaN.
+ *   Keys are copied into the states by assignment.
+ *   Group states are not to be manipulated outside the interface.
+ *
+ * All functions aside from aggregate_init expect an initialized aggregation, providing an uninitialized aggregation
+ *  shall be undefined behavior.
+ * The function aggregate_init expects an uninitialized aggregation, providing an initialized aggregation shall be
+ *  undefined behavior.
+ * Group states are only valid after aggregate_finish, until the next call to aggregate_add, aggregate_clear, or
+ *  aggregate_free. Passing states to functions outside that window shall be undefined behavior.
+ */
+
+#define AGGREGATE_BATCH 256
+
+typedef struct aggregate_row_t
+{
+	table_key_t key;
+	double value;
+} aggregate_row_t;
+
+typedef struct aggregate_state_t
+{
+	table_key_t key;
+	size_t count;
+	double sum;
+	double min;
+	double max;
+} aggregate_state_t;
+
+typedef struct aggregate_t
+{
+	/* implementation defined, use aggregate_state_t for groups */
+} aggregate_t;
+
+/**
+ * Initializes the given aggregation.
+ * @param aggregate A pointer to an uninitialized aggregation.
+ * @param expected_groups The expected number of distinct keys, used to pre-size the state tables and choose the
+ *  number of radix partitions, 0 if unknown (no partitioning).
+ * @param cache_bytes The budget in bytes that each partition's state table and states should fit, 0 selects the size
+ *  of the last-level cache.
+ * @param config A pointer to the configuration of every state table (its concurrency, reclaimer, and index are
+ *  ignored), NULL for the default.
+ * @return 1 on success, 0 on allocation failure leaving the aggregation uninitialized.
+ */
+int aggregate_init(aggregate_t* aggregate, size_t expected_groups, size_t cache_bytes, const table_config_t* config);
+
+/**
+ * Releases resources used by the given aggregation.
+ * The aggregation will become in an uninitialized state after this call.
+ * @param aggregate A pointer to an initialized aggregation.
+ */
+void aggregate_free(aggregate_t* aggregate);
+
+/**
+ * Discards every row and group of the given aggregation, keeping its partitioning and allocations.
+ * @param aggregate A pointer to an initialized aggregation.
+ */
+void aggregate_clear(aggregate_t* aggregate);
+
+/**
+ * Ingests rows into the aggregation.
+ * @param aggregate A pointer to an initialized aggregation.
+ * @param rows An array of n rows.
+ * @param n The number of rows.
+ * @return 1 on success, 0 on allocation failure, in which case a prefix of the rows may have been ingested.
+ */
+int aggregate_add(aggregate_t* aggregate, const aggregate_row_t* rows, size_t n);
+
+/**
+ * Aggregates every buffered row, making the group states available.
+ * Further rows may be added afterwards, followed by another aggregate_finish.
+ * @param aggregate A pointer to an initialized aggregation.
+ * @return 1 on success, 0 on allocation failure.
+ */
+int aggregate_finish(aggregate_t* aggregate);
+
+/**
+ * Returns the number of groups of a finished aggregation.
+ * @param aggregate A pointer to an initialized, finished aggregation.
+ * @return The number of distinct keys ingested.
+ */
+size_t aggregate_groups(const aggregate_t* aggregate);
+
+/**
+ * Returns the state of a group of a finished aggregation.
+ * @param aggregate A pointer to an initialized, finished aggregation.
+ * @param key A pointer to the key.
+ * @return The state of the group of the key, NULL if no row had the key.
+ */
+const aggregate_state_t* aggregate_find(const aggregate_t* aggregate, const table_key_t* key);
+
+/**
+ * Returns the first group state of a finished aggregation, in an implementation-defined order.
+ * @param aggregate A pointer to an initialized, finished aggregation.
+ * @return The first state, NULL if there are no groups.
+ */
+const aggregate_state_t* aggregate_begin(const aggregate_t* aggregate);
+
+/**
+ * Returns the group state proceeding a given state.
+ * @param aggregate A pointer to an initialized, finished aggregation.
+ * @param state A valid state of the aggregation.
+ * @return The next state, NULL on end reached.
+ */
+const aggregate_state_t* aggregate_next(const aggregate_t* aggregate, const aggregate_state_t* state);
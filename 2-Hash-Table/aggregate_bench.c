@@ -0,0 +1,119 @@
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "table.h"
+#include "bench_util.h"
+#include "aggregate.h"
+
+/* Group-by throughput of aggregate_t against the per-row loop it replaces: table_find_mut per row, table_insert of a
+ *  new group whose state is heap-boxed (the int table value indexes an array of malloc'd states).
+ * Run with an optional row count, group count and chunk size: aggregate_bench.out [rows] [groups] [chunk] */
+
+int main(int argc, char** argv)
+{
+	size_t rows_count = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 100000000;
+	size_t group_count = argc > 2 ? (size_t)strtoul(argv[2], NULL, 10) : 1000000;
+	size_t chunk = argc > 3 ? (size_t)strtoul(argv[3], NULL, 10) : 4096;
+	uint64_t state = 0x5EED;
+	aggregate_row_t* rows;
+	aggregate_state_t** boxed;
+	const aggregate_state_t* group;
+	aggregate_t aggregate;
+	table_t table;
+	double checksum[2] = { 0, 0 };
+	double start;
+	double seconds[2];
+	table_value_t boxes = 0;
+	size_t i;
+
+	if (rows_count == 0 || group_count == 0 || group_count > INT_MAX || chunk == 0)
+	{
+		fprintf(stderr, "usage: %s [rows] [groups] [chunk]\n", argv[0]);
+		return 1;
+	}
+
+	rows = (aggregate_row_t*)malloc(rows_count * sizeof(aggregate_row_t));
+	boxed = (aggregate_state_t**)malloc(group_count * sizeof(aggregate_state_t*));
+
+	if (!rows || !boxed)
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+
+	for (i = 0; i < rows_count; ++i)
+	{
+		rows[i].key = (table_key_t)(bench_xorshift64(&state) % group_count);
+		rows[i].value = (double)(bench_xorshift64(&state) % 1000) / 10;
+	}
+
+	/* naive per-row loop */
+	start = bench_now();
+	table_init(&table);
+
+	for (i = 0; i < rows_count; ++i)
+	{
+		table_iter_t iter = table_find_mut(&table, &rows[i].key);
+		aggregate_state_t* box;
+
+		if (iter == table_end(&table))
+		{
+			box = (aggregate_state_t*)malloc(sizeof(aggregate_state_t));
+			box->key = rows[i].key;
+			box->count = 0;
+			box->sum = 0;
+			box->min = box->max = rows[i].value;
+			boxed[boxes] = box;
+			table_insert(&table, &rows[i].key, &boxes, TRANSIENT, TRANSIENT);
+			++boxes;
+		}
+		else
+			box = boxed[*table_value(&table, iter)];
+
+		box->count += 1;
+		box->sum += rows[i].value;
+		box->min = fmin(box->min, rows[i].value);
+		box->max = fmax(box->max, rows[i].value);
+	}
+
+	seconds[0] = bench_now() - start;
+
+	for (i = 0; i < (size_t)boxes; ++i)
+	{
+		checksum[0] += boxed[i]->sum + boxed[i]->count;
+		free(boxed[i]);
+	}
+
+	table_free(&table);
+
+	/* batched operator, fed in chunks as a stream would be */
+	start = bench_now();
+
+	if (!aggregate_init(&aggregate, group_count, 0, NULL))
+	{
+		fprintf(stderr, "aggregate_init failed\n");
+		return 1;
+	}
+
+	for (i = 0; i < rows_count; i += chunk)
+		aggregate_add(&aggregate, rows + i, rows_count - i < chunk ? rows_count - i : chunk);
+
+	aggregate_finish(&aggregate);
+	seconds[1] = bench_now() - start;
+
+	for (group = aggregate_begin(&aggregate); group; group = aggregate_next(&aggregate, group))
+		checksum[1] += group->sum + group->count;
+
+	printf("%zu rows, %zu groups (%lu found), chunks of %zu\n", rows_count, group_count,
+		(unsigned long)aggregate_groups(&aggregate), chunk);
+	printf("%-10s %8.3f s %8.1f Mrows/s checksum %.1f\n", "per-row", seconds[0], rows_count / seconds[0] / 1e6,
+		checksum[0]);
+	printf("%-10s %8.3f s %8.1f Mrows/s checksum %.1f\n", "aggregate", seconds[1], rows_count / seconds[1] / 1e6,
+		checksum[1]);
+
+	aggregate_free(&aggregate);
+	free(boxed);
+	free(rows);
+	return 0;
+}
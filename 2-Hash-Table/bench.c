@@ -0,0 +1,550 @@
+#define _POSIX_C_SOURCE 199309L
+#define _DEFAULT_SOURCE /* syscall for perf_event_open */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "table.h"
+#include "bench_util.h"
+
+#ifdef __linux__
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+#endif
+
+/* Workload benchmark for table_t. Every run builds a table of the requested size, generates an operation trace up
+ *  front (so key generation is not measured), replays it once for throughput and once more on a fresh table timed in
+ *  batches of LATENCY_BATCH operations for latency percentiles. The percentiles are over the mean latency of each
+ *  batch, since a clock read per operation costs as much as an L1-resident lookup and would dominate p50 and p99.
+ *  Results are printed and appended as CSV to the output file.
+ *
+ * Usage: bench.out [--sizes n,n,...] [--ops n] [--workload name|all] [--dist uniform|zipf|all] [--theta t]
+ *  [--hit ratio] [--engine default|cuckoo] [--layout default|dense] [--hasher default|mix|bytes|sip]
+ *  [--pages default|huge] [--numa default|interleave|first-touch] [--seed n] [--output path]
+ *
+ * Present keys are even, absent keys are odd, so a read misses exactly when its key is odd. Bytes per entry is the
+ *  growth of the resident set while building and running, so it is only meaningful for tables spanning many pages. dTLB
+ *  load misses per operation of the throughput replay are read through perf_event_open on Linux, -1 where the counter
+ *  is unavailable; compare --pages default with --pages huge on tables far beyond the LLC. */
+
+#define MAX_SIZES 16
+#define LIVE_KEY -1 /* an OP_READ of the current live key of its slot */
+#define LATENCY_BATCH 64
+
+typedef enum op_kind
+{
+	OP_READ, OP_UPDATE, OP_INSERT, OP_CHURN
+} op_kind;
+
+typedef struct workload
+{
+	const char* name;
+	double read;
+	double update;
+	double insert; /* the rest of the mix is OP_CHURN (erase a present key, insert a fresh one) */
+} workload;
+
+typedef struct op
+{
+	unsigned char kind;
+	size_t slot; /* index into the live key array */
+	table_key_t key; /* key for OP_READ, OP_INSERT, and the fresh key of OP_CHURN */
+} op;
+
+typedef struct options
+{
+	size_t sizes[MAX_SIZES];
+	size_t size_count;
+	size_t ops;
+	const char* workload;
+	const char* dist;
+	double theta;
+	double hit;
+	table_config_t config;
+	const char* hasher;
+	uint64_t seed;
+	const char* output;
+} options;
+
+typedef struct zipf
+{
+	size_t n;
+	double theta;
+	double alpha;
+	double zeta2;
+	double eta;
+	double zetan;
+} zipf;
+
+typedef struct result
+{
+	double mops;
+	double p50;
+	double p99;
+	double p999;
+	double bytes_per_entry;
+	double tlb_misses;
+} result;
+
+static const workload workloads[] = {
+	{ "read-only", 1.0, 0.0, 0.0 },
+	{ "read-heavy", 0.95, 0.05, 0.0 },
+	{ "update-heavy", 0.5, 0.5, 0.0 },
+	{ "insert-only", 0.0, 0.0, 1.0 },
+	{ "erase-churn", 0.0, 0.0, 0.0 }
+};
+
+static int parse_options(options* opts, int argc, char** argv);
+static double uniform01(uint64_t* state);
+static void zipf_init(zipf* z, size_t n, double theta);
+static size_t zipf_next(const zipf* z, uint64_t* state);
+static size_t scatter(size_t rank, size_t n);
+static op* make_trace(const workload* w, size_t n, size_t ops, const zipf* z, double hit, uint64_t seed);
+static void build(table_t* table, const options* opts, table_key_t* live, size_t n, int populate);
+static void replay(table_t* table, table_key_t* live, const op* trace, size_t first, size_t last);
+static void run(table_t* table, table_key_t* live, const op* trace, size_t ops, double* latencies);
+static int tlb_counter_open(void);
+static void counter_start(int counter);
+static double counter_stop(int counter);
+static long resident_bytes(void);
+static int compare_double(const void* left, const void* right);
+static double percentile(const double* sorted, size_t count, double p);
+
+int main(int argc, char** argv)
+{
+	options opts;
+	FILE* csv;
+	size_t s, w;
+	int counter;
+	int d;
+
+	if (!parse_options(&opts, argc, argv))
+		return 1;
+
+	csv = fopen(opts.output, "a");
+
+	if (!csv)
+	{
+		printf("Unable to open %s.\n", opts.output);
+		return 1;
+	}
+
+	fseek(csv, 0, SEEK_END);
+
+	if (ftell(csv) == 0)
+		fprintf(csv, "workload,dist,size,hit,engine,layout,hasher,pages,numa,seed,ops,mops,p50_ns,p99_ns,p999_ns,"
+			"bytes_per_entry,dtlb_misses_per_op\n");
+
+	counter = tlb_counter_open();
+	printf("%-13s %-8s %10s %5s %10s %9s %9s %9s %11s %8s\n",
+		"workload", "dist", "size", "hit", "Mops/s", "p50 ns", "p99 ns", "p99.9 ns", "bytes/entry", "dTLB/op");
+
+	for (s = 0; s < opts.size_count; ++s)
+	{
+		size_t n = opts.sizes[s];
+		size_t ops = opts.ops ? opts.ops : (n < 1000000 ? 1000000 : n);
+		zipf z;
+
+		zipf_init(&z, n, opts.theta);
+
+		for (w = 0; w < sizeof(workloads)/sizeof(workloads[0]); ++w)
+		{
+			const workload* wl = &workloads[w];
+			int insert_only = wl->insert == 1.0;
+
+			if (strcmp(opts.workload, "all") != 0 && strcmp(opts.workload, wl->name) != 0)
+				continue;
+
+			for (d = 0; d < 2; ++d)
+			{
+				const char* dist = d ? "zipf" : "uniform";
+				size_t trace_ops = insert_only ? n : ops;
+				size_t batches = (trace_ops + LATENCY_BATCH - 1) / LATENCY_BATCH;
+				table_key_t* live;
+				double* latencies;
+				op* trace;
+				table_t table;
+				result r;
+				long before;
+				double start;
+
+				if (strcmp(opts.dist, "all") != 0 && strcmp(opts.dist, dist) != 0)
+					continue;
+
+				live = (table_key_t*)malloc(n * sizeof(table_key_t));
+				latencies = (double*)malloc(batches * sizeof(double));
+				trace = make_trace(wl, n, trace_ops, d ? &z : NULL, opts.hit, opts.seed);
+
+				if (!live || !latencies || !trace)
+				{
+					printf("Allocation failed for size %zu.\n", n);
+					return 1;
+				}
+
+				before = resident_bytes();
+				build(&table, &opts, live, n, !insert_only);
+				counter_start(counter);
+				start = bench_now();
+				run(&table, live, trace, trace_ops, NULL);
+				r.mops = trace_ops / (bench_now() - start) / 1e6;
+				r.tlb_misses = counter_stop(counter);
+				r.tlb_misses = r.tlb_misses < 0 ? -1.0 : r.tlb_misses / trace_ops;
+				r.bytes_per_entry = table_size(&table)
+					? (double)(resident_bytes() - before) / table_size(&table) : 0.0;
+				table_free(&table);
+
+				build(&table, &opts, live, n, !insert_only);
+				run(&table, live, trace, trace_ops, latencies);
+				table_free(&table);
+
+				qsort(latencies, batches, sizeof(double), compare_double);
+				r.p50 = percentile(latencies, batches, 0.5);
+				r.p99 = percentile(latencies, batches, 0.99);
+				r.p999 = percentile(latencies, batches, 0.999);
+
+				printf("%-13s %-8s %10zu %5.2f %10.2f %9.0f %9.0f %9.0f %11.1f %8.3f\n",
+					wl->name, dist, n, opts.hit, r.mops, r.p50, r.p99, r.p999, r.bytes_per_entry, r.tlb_misses);
+				fprintf(csv, "%s,%s,%zu,%.3f,%s,%s,%s,%s,%s,%llu,%zu,%.4f,%.1f,%.1f,%.1f,%.2f,%.4f\n",
+					wl->name, dist, n, opts.hit, opts.config.engine == TABLE_ENGINE_CUCKOO ? "cuckoo" : "default",
+					opts.config.layout == TABLE_LAYOUT_DENSE ? "dense" : "default", opts.hasher,
+					opts.config.pages == TABLE_PAGES_HUGE ? "huge" : "default",
+					opts.config.numa == TABLE_NUMA_INTERLEAVE ? "interleave"
+						: opts.config.numa == TABLE_NUMA_FIRST_TOUCH ? "first-touch" : "default",
+					(unsigned long long)opts.seed, trace_ops, r.mops, r.p50, r.p99, r.p999, r.bytes_per_entry,
+					r.tlb_misses);
+				fflush(csv);
+
+				free(live);
+				free(latencies);
+				free(trace);
+			}
+		}
+	}
+
+	if (counter >= 0)
+		close(counter);
+
+	fclose(csv);
+	return 0;
+}
+
+static int parse_options(options* opts, int argc, char** argv)
+{
+	static const size_t default_sizes[] = { 1 << 10, 1 << 14, 1 << 18, 1 << 22, 1 << 24 };
+	int i;
+
+	memset(opts, 0, sizeof(options));
+	memcpy(opts->sizes, default_sizes, sizeof(default_sizes));
+	opts->size_count = sizeof(default_sizes)/sizeof(default_sizes[0]);
+	opts->workload = "all";
+	opts->dist = "all";
+	opts->theta = 0.99;
+	opts->hit = 0.9;
+	opts->hasher = "default";
+	opts->seed = 0x5EED;
+	opts->output = "bench_results.csv";
+
+	for (i = 1; i + 1 < argc; i += 2)
+	{
+		const char* name = argv[i];
+		const char* value = argv[i + 1];
+
+		if (strcmp(name, "--sizes") == 0)
+		{
+			char* end = (char*)value;
+
+			for (opts->size_count = 0; opts->size_count < MAX_SIZES && *end; ++opts->size_count)
+			{
+				opts->sizes[opts->size_count] = (size_t)strtoull(end, &end, 10);
+
+				if (opts->sizes[opts->size_count] == 0 || (*end && *end != ','))
+				{
+					printf("Invalid size list %s, sizes must be positive integers.\n", value);
+					return 0;
+				}
+
+				end += *end == ',';
+			}
+		}
+		else if (strcmp(name, "--ops") == 0)
+			opts->ops = (size_t)strtoull(value, NULL, 10);
+		else if (strcmp(name, "--workload") == 0)
+			opts->workload = value;
+		else if (strcmp(name, "--dist") == 0)
+			opts->dist = value;
+		else if (strcmp(name, "--theta") == 0)
+			opts->theta = strtod(value, NULL);
+		else if (strcmp(name, "--hit") == 0)
+			opts->hit = strtod(value, NULL);
+		else if (strcmp(name, "--engine") == 0)
+			opts->config.engine = strcmp(value, "cuckoo") == 0 ? TABLE_ENGINE_CUCKOO : TABLE_ENGINE_DEFAULT;
+		else if (strcmp(name, "--layout") == 0)
+			opts->config.layout = strcmp(value, "dense") == 0 ? TABLE_LAYOUT_DENSE : TABLE_LAYOUT_DEFAULT;
+		else if (strcmp(name, "--hasher") == 0)
+		{
+			opts->hasher = value;
+			opts->config.hasher = strcmp(value, "mix") == 0 ? table_hash_mix
+				: strcmp(value, "bytes") == 0 ? table_hash_key_bytes
+				: strcmp(value, "sip") == 0 ? table_hash_sip : NULL;
+		}
+		else if (strcmp(name, "--pages") == 0)
+			opts->config.pages = strcmp(value, "huge") == 0 ? TABLE_PAGES_HUGE : TABLE_PAGES_DEFAULT;
+		else if (strcmp(name, "--numa") == 0)
+			opts->config.numa = strcmp(value, "interleave") == 0 ? TABLE_NUMA_INTERLEAVE
+				: strcmp(value, "first-touch") == 0 ? TABLE_NUMA_FIRST_TOUCH : TABLE_NUMA_DEFAULT;
+		else if (strcmp(name, "--seed") == 0)
+			opts->seed = (uint64_t)strtoull(value, NULL, 10);
+		else if (strcmp(name, "--output") == 0)
+			opts->output = value;
+		else
+		{
+			printf("Unknown option %s.\n", name);
+			return 0;
+		}
+	}
+
+	opts->config.seed = opts->seed;
+	return 1;
+}
+
+static double uniform01(uint64_t* state)
+{
+	return (bench_xorshift64(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* Gray et al., "Quickly Generating Billion-Record Synthetic Databases", as used by YCSB. */
+static void zipf_init(zipf* z, size_t n, double theta)
+{
+	size_t i;
+
+	z->n = n;
+	z->theta = theta;
+	z->zetan = 0.0;
+
+	for (i = 1; i <= n; ++i)
+		z->zetan += 1.0 / pow((double)i, theta);
+
+	z->zeta2 = 1.0 + 1.0 / pow(2.0, theta);
+	z->alpha = 1.0 / (1.0 - theta);
+	z->eta = (1.0 - pow(2.0 / n, 1.0 - theta)) / (1.0 - z->zeta2 / z->zetan);
+}
+
+static size_t zipf_next(const zipf* z, uint64_t* state)
+{
+	double u = uniform01(state);
+	double uz = u * z->zetan;
+	size_t rank;
+
+	if (uz < 1.0)
+		return 0;
+
+	if (uz < z->zeta2)
+		return 1;
+
+	rank = (size_t)(z->n * pow(z->eta * u - z->eta + 1.0, z->alpha));
+	return rank < z->n ? rank : z->n - 1;
+}
+
+/* spreads popular ranks over the key space so hot keys do not share cache lines by construction */
+static size_t scatter(size_t rank, size_t n)
+{
+	return (size_t)(((uint64_t)rank * UINT64_C(0x9E3779B97F4A7C15)) % n);
+}
+
+static op* make_trace(const workload* w, size_t n, size_t ops, const zipf* z, double hit, uint64_t seed)
+{
+	op* trace = (op*)malloc(ops * sizeof(op));
+	uint64_t state = seed | 1;
+	size_t fresh = n;
+	size_t i;
+
+	if (!trace)
+		return NULL;
+
+	for (i = 0; i < ops; ++i)
+	{
+		double pick = uniform01(&state);
+		size_t slot = z ? scatter(zipf_next(z, &state), n) : (size_t)(bench_xorshift64(&state) % n);
+
+		trace[i].slot = slot;
+		trace[i].key = 0;
+
+		if (pick < w->read)
+		{
+			trace[i].kind = OP_READ;
+			trace[i].key = uniform01(&state) < hit ? LIVE_KEY : (table_key_t)(2 * slot + 1);
+		}
+		else if (pick < w->read + w->update)
+			trace[i].kind = OP_UPDATE;
+		else if (pick < w->read + w->update + w->insert)
+		{
+			trace[i].kind = OP_INSERT;
+			trace[i].slot = i;
+			trace[i].key = (table_key_t)(2 * i);
+		}
+		else
+		{
+			trace[i].kind = OP_CHURN;
+			trace[i].key = (table_key_t)(2 * fresh++);
+		}
+	}
+
+	return trace;
+}
+
+static void build(table_t* table, const options* opts, table_key_t* live, size_t n, int populate)
+{
+	size_t i;
+
+	table_init_config(table, &opts->config);
+
+	for (i = 0; i < n; ++i)
+	{
+		live[i] = (table_key_t)(2 * i);
+
+		if (populate)
+			table_insert(table, &live[i], &live[i], TRANSIENT, TRANSIENT);
+	}
+}
+
+static void replay(table_t* table, table_key_t* live, const op* trace, size_t first, size_t last)
+{
+	static volatile size_t found = 0;
+	table_value_t value;
+	size_t i;
+
+	for (i = first; i < last; ++i)
+	{
+		const op* o = &trace[i];
+		table_key_t key = o->key;
+
+		switch (o->kind)
+		{
+			case OP_READ:
+				if (key == LIVE_KEY)
+					key = live[o->slot];
+
+				found += table_find(table, &key) != table_end(table);
+				break;
+
+			case OP_UPDATE:
+				value = (table_value_t)i;
+				table_assign(table, table_find_mut(table, &live[o->slot]), &value, TRANSIENT);
+				break;
+
+			case OP_INSERT:
+				table_insert(table, &key, &key, TRANSIENT, TRANSIENT);
+				break;
+
+			case OP_CHURN:
+				table_erase(table, table_find_mut(table, &live[o->slot]));
+				live[o->slot] = key;
+				table_insert(table, &key, &key, TRANSIENT, TRANSIENT);
+				break;
+		}
+	}
+}
+
+/* latencies, if not NULL, receives the mean ns per operation of every batch of LATENCY_BATCH operations */
+static void run(table_t* table, table_key_t* live, const op* trace, size_t ops, double* latencies)
+{
+	size_t first, last;
+	double start;
+
+	if (!latencies)
+	{
+		replay(table, live, trace, 0, ops);
+		return;
+	}
+
+	for (first = 0; first < ops; first = last)
+	{
+		last = ops - first < LATENCY_BATCH ? ops : first + LATENCY_BATCH;
+		start = bench_now();
+		replay(table, live, trace, first, last);
+		latencies[first / LATENCY_BATCH] = (bench_now() - start) * 1e9 / (last - first);
+	}
+}
+
+/* dTLB load miss counter of the calling thread (Linux), -1 where unavailable */
+static int tlb_counter_open(void)
+{
+#ifdef __linux__
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.type = PERF_TYPE_HW_CACHE;
+	attr.size = sizeof(attr);
+	attr.config = PERF_COUNT_HW_CACHE_DTLB | PERF_COUNT_HW_CACHE_OP_READ << 8
+		| PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+
+	return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+	return -1;
+#endif
+}
+
+static void counter_start(int counter)
+{
+#ifdef __linux__
+	if (counter >= 0)
+	{
+		ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+		ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+	}
+#else
+	(void)counter;
+#endif
+}
+
+static double counter_stop(int counter)
+{
+#ifdef __linux__
+	long long count;
+
+	if (counter < 0)
+		return -1.0;
+
+	ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+	return read(counter, &count, sizeof(count)) == sizeof(count) ? (double)count : -1.0;
+#else
+	(void)counter;
+	return -1.0;
+#endif
+}
+
+/* resident set size from /proc (Linux), 0 where unavailable */
+static long resident_bytes(void)
+{
+	FILE* statm = fopen("/proc/self/statm", "r");
+	long size = 0;
+	long resident = 0;
+
+	if (!statm)
+		return 0;
+
+	if (fscanf(statm, "%ld %ld", &size, &resident) != 2)
+		resident = 0;
+
+	fclose(statm);
+	return resident * sysconf(_SC_PAGESIZE);
+}
+
+static int compare_double(const void* left, const void* right)
+{
+	double l = *(const double*)left;
+	double r = *(const double*)right;
+
+	return (l > r) - (l < r);
+}
+
+static double percentile(const double* sorted, size_t count, double p)
+{
+	return count ? sorted[(size_t)(p * (count - 1))] : 0.0;
+}
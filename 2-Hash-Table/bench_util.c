@@ -0,0 +1,21 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <time.h>
+#include "bench_util.h"
+
+uint64_t bench_xorshift64(uint64_t* state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+
+	return *state;
+}
+
+double bench_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdint.h>
+
+/* Helpers shared by the benchmark programs (bench.c, hash_bench.c, cache_bench.c, aggregate_bench.c). */
+
+/**
+ * Advances a xorshift64 generator.
+ * @param state A pointer to the generator state, which must not be 0.
+ * @return The new state, a pseudo-random 64-bit value.
+ */
+uint64_t bench_xorshift64(uint64_t* state);
+
+/**
+ * Returns the current time of a monotonic clock.
+ * @return The time in seconds, only meaningful as the difference of two calls.
+ */
+double bench_now(void);
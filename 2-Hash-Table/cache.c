@@ -0,0 +1,42 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include "cache.h"
+
+/* Cache interface implementation */
+
+void cache_init(cache_t* cache, size_t capacity, cache_policy_t policy, const table_config_t* config);
+
+void cache_free(cache_t* cache);
+
+void cache_clear(cache_t* cache);
+
+size_t cache_size(const cache_t* cache);
+
+cache_entry_t* cache_get(cache_t* cache, const table_key_t* key);
+const cache_entry_t* cache_peek(const cache_t* cache, const table_key_t* key);
+
+cache_entry_t* cache_put(cache_t* cache, table_key_t* key, table_value_t* value,
+	storage_mode key_storage_mode, storage_mode value_storage_mode, int* inserted);
+
+void cache_erase(cache_t* cache, cache_entry_t* entry);
+
+const table_key_t* cache_key(const cache_t* cache, const cache_entry_t* entry);
+
+const table_value_t* cache_value(const cache_t* cache, const cache_entry_t* entry);
+
+
+/* Sharded cache interface implementation */
+
+int sharded_cache_init(sharded_cache_t* cache, size_t shard_count, size_t capacity, cache_policy_t policy,
+	const table_config_t* config);
+
+void sharded_cache_free(sharded_cache_t* cache);
+
+size_t sharded_cache_size(const sharded_cache_t* cache);
+
+int sharded_cache_get(sharded_cache_t* cache, const table_key_t* key, table_value_t* out);
+
+void sharded_cache_put(sharded_cache_t* cache, table_key_t* key, table_value_t* value,
+	storage_mode key_storage_mode, storage_mode value_storage_mode, int* inserted);
+
+int sharded_cache_erase(sharded_cache_t* cache, const table_key_t* key);
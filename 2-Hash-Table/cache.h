@@ -0,0 +1,206 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include "table.h"
+
+/**
+ * The cache_t type implements a bounded key-value cache with LRU or CLOCK eviction.
+ *
+ * Implementation-defined specification:
+ *   cache_entry_t: Entry structure type definition.
+ *   cache_t: Cache structure type definition.
+ *   sharded_cache_t: Concurrent cache structure type definition.
+ *
+ * Expectations:
+ *   Entries embed their recency links, so the hash index and the recency order share one allocation per entry. A hit
+ *    relinks in O(1) without allocating or freeing memory.
+ *   Keys and values follow the storage modes of table.h. When an entry is evicted, erased, or cleared, its key and
+ *    value are released according to their own storage modes exactly as table_erase would (key_destructor and
+ *    value_destructor for TRANSFER and non-inline TRANSIENT memory, nothing for STATIC or inline memory).
+ *   CACHE_LRU moves every hit to the front of the recency list and evicts from the back.
+ *   CACHE_CLOCK sets a reference bit on a hit, only writing it (with a relaxed atomic store) when it is clear, so hits
+ *    on hot entries do not write shared memory. New entries start with the bit clear. Eviction sweeps a hand over the
+ *    entries in insertion order, clearing set bits and evicting the first entry whose bit is clear (second chance).
+ *   sharded_cache_t routes keys to independently locked caches by the high bits of their hash. Its lookups copy the
+ *    value out (with value_duplicator) while the entry is guaranteed to be alive, since another thread may evict it
+ *    right after.
+ *   Under CACHE_CLOCK a sharded hit takes no lock: it runs inside an epoch read-side critical section of the shard (as
+ *    TABLE_CONCURRENCY_EPOCH, the cache registering a reader slot for each calling thread on its first call), sets the
+ *    reference bit as above, and copies the value before leaving, so a hit on a hot entry only writes the calling
+ *    thread's own epoch slot. Inserts, evictions, and erasures hold the shard's mutex exclusively, a replacing put
+ *    publishes a new entry instead of writing the value in place, and evicted, erased, or replaced entries are retired
+ *    and only released once every reader has left. Under CACHE_LRU every operation holds the shard's mutex
+ *    exclusively, since a hit relinks the entry. Threads are POSIX threads.
+ *   Cache entries are not to be accessed or manipulated outside the interface.
+ *
+ * All functions aside from cache_init and sharded_cache_init expect an initialized cache, providing an uninitialized
+ *  cache shall be undefined behavior.
+ * The functions cache_init and sharded_cache_init expect an uninitialized cache, providing an initialized cache shall
+ *  be undefined behavior.
+ * Passing entries that were evicted or erased to functions shall be undefined behavior.
+ */
+
+typedef enum cache_policy_t
+{
+	CACHE_LRU, CACHE_CLOCK
+} cache_policy_t;
+
+typedef struct cache_entry_t
+{
+	table_node_t node; /* key and value, as in table.h */
+	struct cache_entry_t* prev;
+	struct cache_entry_t* next;
+	atomic_uchar referenced; /* CACHE_CLOCK only */
+} cache_entry_t;
+
+typedef struct cache_t
+{
+	/* implementation defined, use cache_entry_t for entries */
+} cache_t;
+
+typedef struct sharded_cache_t
+{
+	/* implementation defined */
+} sharded_cache_t;
+
+/**
+ * Initializes the given cache.
+ * @param cache A pointer to an uninitialized cache.
+ * @param capacity The maximum number of entries, at least 1.
+ * @param policy The eviction policy.
+ * @param config A pointer to a configuration whose hasher and seed are used (other options are ignored), NULL for
+ *  the default.
+ */
+void cache_init(cache_t* cache, size_t capacity, cache_policy_t policy, const table_config_t* config);
+
+/**
+ * Releases resources used by the given cache, releasing every entry.
+ * The cache will become in an uninitialized state after this call.
+ * @param cache A pointer to an initialized cache.
+ */
+void cache_free(cache_t* cache);
+
+/**
+ * Releases every entry of the given cache.
+ * @param cache A pointer to an initialized cache.
+ */
+void cache_clear(cache_t* cache);
+
+/**
+ * Returns the number of entries in the given cache.
+ * @param cache A pointer to an initialized cache.
+ * @return The number of entries, at most the capacity.
+ */
+size_t cache_size(const cache_t* cache);
+
+/**
+ * Looks up a key and records the hit for the eviction policy.
+ * @param cache A pointer to an initialized cache.
+ * @param key A pointer to the key.
+ * @return The entry of the key, NULL on miss.
+ */
+cache_entry_t* cache_get(cache_t* cache, const table_key_t* key);
+
+/**
+ * Looks up a key without recording a hit.
+ * @param cache A pointer to an initialized cache.
+ * @param key A pointer to the key.
+ * @return The entry of the key, NULL on miss.
+ */
+const cache_entry_t* cache_peek(const cache_t* cache, const table_key_t* key);
+
+/**
+ * Inserts a key-value pair, or replaces the value of an existing key (releasing the old value and keeping the old key,
+ *  whose passed memory then remains managed by the caller), and records it as most recently used.
+ * When a new entry would exceed the capacity, an entry chosen by the policy is evicted first.
+ * @param cache A pointer to an initialized cache.
+ * @param key A pointer to the key.
+ * @param value A pointer to the value.
+ * @param key_storage_mode The storage mode of the key.
+ * @param value_storage_mode The storage mode of the value.
+ * @param inserted A pointer receiving 1 if an entry was inserted (taking the key) and 0 if the value of an existing
+ *  key was replaced (leaving the key with the caller), may only be NULL if key_storage_mode is not TRANSFER.
+ * @return The entry of the key.
+ */
+cache_entry_t* cache_put(cache_t* cache, table_key_t* key, table_value_t* value,
+	storage_mode key_storage_mode, storage_mode value_storage_mode, int* inserted);
+
+/**
+ * Erases an entry from the cache.
+ * @param cache A pointer to an initialized cache.
+ * @param entry A valid entry of the cache.
+ */
+void cache_erase(cache_t* cache, cache_entry_t* entry);
+
+/**
+ * Returns the key associated with an entry.
+ * @param cache A pointer to an initialized cache.
+ * @param entry A valid entry of the cache.
+ * @return A pointer to the key associated with the entry.
+ */
+const table_key_t* cache_key(const cache_t* cache, const cache_entry_t* entry);
+
+/**
+ * Returns the value associated with an entry.
+ * @param cache A pointer to an initialized cache.
+ * @param entry A valid entry of the cache.
+ * @return A pointer to the value associated with the entry.
+ */
+const table_value_t* cache_value(const cache_t* cache, const cache_entry_t* entry);
+
+/**
+ * Initializes the given sharded cache.
+ * @param cache A pointer to an uninitialized sharded cache.
+ * @param shard_count The number of shards, a power of two.
+ * @param capacity The maximum number of entries over all shards, split evenly between them.
+ * @param policy The eviction policy of every shard.
+ * @param config A pointer to a configuration whose hasher and seed are used, NULL for the default.
+ * @return 1 on success, 0 on failure leaving the cache uninitialized.
+ */
+int sharded_cache_init(sharded_cache_t* cache, size_t shard_count, size_t capacity, cache_policy_t policy,
+	const table_config_t* config);
+
+/**
+ * Releases resources used by the given sharded cache, releasing every entry and the reader slots of the threads that
+ *  used it. No other thread may be calling into the cache.
+ * The cache will become in an uninitialized state after this call.
+ * @param cache A pointer to an initialized sharded cache.
+ */
+void sharded_cache_free(sharded_cache_t* cache);
+
+/**
+ * Returns the number of entries in the given sharded cache.
+ * @param cache A pointer to an initialized sharded cache.
+ * @return The sum of the sizes of the shards.
+ */
+size_t sharded_cache_size(const sharded_cache_t* cache);
+
+/**
+ * Looks up a key, records the hit, and copies its value. Safe to call from any thread.
+ * @param cache A pointer to an initialized sharded cache.
+ * @param key A pointer to the key.
+ * @param out A pointer receiving a copy of the value (made with value_duplicator) on hit.
+ * @return 1 on hit, 0 on miss.
+ */
+int sharded_cache_get(sharded_cache_t* cache, const table_key_t* key, table_value_t* out);
+
+/**
+ * Inserts or replaces a key-value pair, see cache_put. Safe to call from any thread.
+ * @param cache A pointer to an initialized sharded cache.
+ * @param key A pointer to the key.
+ * @param value A pointer to the value.
+ * @param key_storage_mode The storage mode of the key.
+ * @param value_storage_mode The storage mode of the value.
+ * @param inserted A pointer receiving 1 if an entry was inserted and 0 if a value was replaced, see cache_put.
+ */
+void sharded_cache_put(sharded_cache_t* cache, table_key_t* key, table_value_t* value,
+	storage_mode key_storage_mode, storage_mode value_storage_mode, int* inserted);
+
+/**
+ * Erases a key from the sharded cache. Safe to call from any thread.
+ * @param cache A pointer to an initialized sharded cache.
+ * @param key A pointer to the key.
+ * @return 1 if the key was erased, 0 if it was not cached.
+ */
+int sharded_cache_erase(sharded_cache_t* cache, const table_key_t* key);
@@ -0,0 +1,206 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "table.h"
+#include "bench_util.h"
+#include "cache.h"
+
+/* Hit-path latency of cache_t and sharded_cache_t. Every key is resident, so each lookup is a hit and the numbers
+ *  isolate the cost of recording recency: table_find on a plain table is the baseline, CACHE_LRU relinks on every hit,
+ *  CACHE_CLOCK only sets a bit. Latencies are per batch of BATCH lookups divided by BATCH, since a clock read per
+ *  lookup would dominate a hit.
+ * Run with an optional entry count, lookup count and thread count: cache_bench.out [entries] [lookups] [threads] */
+
+#define BATCH 64
+#define MAX_THREADS 64
+
+typedef struct shared_run
+{
+	sharded_cache_t* cache;
+	const table_key_t* keys;
+	size_t count;
+	size_t hits;
+} shared_run;
+
+static int compare_doubles(const void* a, const void* b);
+static void report(const char* name, double* batches, size_t count);
+static void* shared_worker(void* context);
+
+int main(int argc, char** argv)
+{
+	static const char* policy_names[] = { "lru", "clock" };
+
+	size_t entries = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 1 << 16;
+	size_t lookups = argc > 2 ? (size_t)strtoul(argv[2], NULL, 10) : 1 << 22;
+	size_t threads = argc > 3 ? (size_t)strtoul(argv[3], NULL, 10) : 4;
+	size_t batch_count = lookups / BATCH;
+	uint64_t state = 0x5EED;
+	table_key_t* keys;
+	double* batches;
+	table_t table;
+	cache_t cache;
+	sharded_cache_t shared;
+	pthread_t workers[MAX_THREADS];
+	shared_run runs[MAX_THREADS];
+	table_key_t k;
+	size_t hits = 0;
+	size_t i, j;
+	int policy;
+
+	if (entries == 0 || batch_count == 0 || threads == 0 || threads > MAX_THREADS)
+	{
+		fprintf(stderr, "usage: %s [entries] [lookups >= %d] [threads <= %d]\n", argv[0], BATCH, MAX_THREADS);
+		return 1;
+	}
+
+	keys = (table_key_t*)malloc(batch_count * BATCH * sizeof(table_key_t));
+	batches = (double*)malloc(batch_count * sizeof(double));
+
+	if (!keys || !batches)
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+
+	for (i = 0; i < batch_count * BATCH; ++i)
+		keys[i] = (table_key_t)(bench_xorshift64(&state) % entries);
+
+	printf("%zu entries, %zu lookups\n", entries, batch_count * BATCH);
+	printf("%-16s %10s %10s %10s %10s\n", "variant", "mean ns", "p50 ns", "p99 ns", "p99.9 ns");
+
+	table_init(&table);
+	table_reserve(&table, entries);
+
+	for (k = 0; k < (table_key_t)entries; ++k)
+		table_insert(&table, &k, &k, TRANSIENT, TRANSIENT);
+
+	for (i = 0; i < batch_count; ++i)
+	{
+		double start = bench_now();
+
+		for (j = 0; j < BATCH; ++j)
+			hits += table_find(&table, &keys[i * BATCH + j]) != table_end(&table);
+
+		batches[i] = (bench_now() - start) * 1e9 / BATCH;
+	}
+
+	report("table_find", batches, batch_count);
+	table_free(&table);
+
+	for (policy = CACHE_LRU; policy <= CACHE_CLOCK; ++policy)
+	{
+		cache_init(&cache, entries, (cache_policy_t)policy, NULL);
+
+		for (k = 0; k < (table_key_t)entries; ++k)
+			cache_put(&cache, &k, &k, TRANSIENT, TRANSIENT, NULL);
+
+		for (i = 0; i < batch_count; ++i)
+		{
+			double start = bench_now();
+
+			for (j = 0; j < BATCH; ++j)
+				hits += cache_get(&cache, &keys[i * BATCH + j]) != NULL;
+
+			batches[i] = (bench_now() - start) * 1e9 / BATCH;
+		}
+
+		report(policy_names[policy], batches, batch_count);
+		cache_free(&cache);
+	}
+
+	for (policy = CACHE_LRU; policy <= CACHE_CLOCK; ++policy)
+	{
+		size_t shards = 1;
+		size_t started;
+		size_t total;
+		double start;
+		double elapsed;
+
+		while (shards < threads * 4)
+			shards <<= 1;
+
+		/* spare capacity per shard, since keys do not split evenly between shards */
+		if (!sharded_cache_init(&shared, shards, entries * 2, (cache_policy_t)policy, NULL))
+		{
+			fprintf(stderr, "sharded_cache_init failed\n");
+			return 1;
+		}
+
+		for (k = 0; k < (table_key_t)entries; ++k)
+			sharded_cache_put(&shared, &k, &k, TRANSIENT, TRANSIENT, NULL);
+
+		start = bench_now();
+
+		for (i = 0; i < threads; ++i)
+		{
+			runs[i].cache = &shared;
+			runs[i].keys = keys + i * (batch_count / threads) * BATCH;
+			runs[i].count = (batch_count / threads) * BATCH;
+			runs[i].hits = 0;
+
+			if (pthread_create(&workers[i], NULL, shared_worker, &runs[i]) != 0)
+				break;
+		}
+
+		started = i;
+
+		for (i = 0; i < started; ++i)
+		{
+			pthread_join(workers[i], NULL);
+			hits += runs[i].hits;
+		}
+
+		elapsed = bench_now() - start;
+
+		if (started < threads)
+		{
+			sharded_cache_free(&shared);
+			fprintf(stderr, "pthread_create failed after %zu threads\n", started);
+			return 1;
+		}
+
+		total = (batch_count / threads) * threads * BATCH;
+		printf("sharded-%-8s %10.1f ns/lookup per thread, %zu threads, %.1f Mlookups/s\n", policy_names[policy],
+			elapsed * 1e9 * threads / total, threads, total / elapsed / 1e6);
+
+		sharded_cache_free(&shared);
+	}
+
+	printf("%zu hits\n", hits); /* keeps the lookups observable */
+	free(batches);
+	free(keys);
+	return 0;
+}
+
+static int compare_doubles(const void* a, const void* b)
+{
+	double x = *(const double*)a;
+	double y = *(const double*)b;
+
+	return (x > y) - (x < y);
+}
+
+static void report(const char* name, double* batches, size_t count)
+{
+	double sum = 0;
+	size_t i;
+
+	for (i = 0; i < count; ++i)
+		sum += batches[i];
+
+	qsort(batches, count, sizeof(double), compare_doubles);
+	printf("%-16s %10.1f %10.1f %10.1f %10.1f\n", name, sum / count, batches[count / 2], batches[count * 99 / 100],
+		batches[count * 999 / 1000]);
+}
+
+static void* shared_worker(void* context)
+{
+	shared_run* run = (shared_run*)context;
+	table_value_t value;
+	size_t i;
+
+	for (i = 0; i < run->count; ++i)
+		run->hits += sharded_cache_get(run->cache, &run->keys[i], &value);
+
+	return NULL;
+}
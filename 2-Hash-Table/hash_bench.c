@@ -0,0 +1,194 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "table.h"
+#include "bench_util.h"
+
+/* Distribution quality of the standard hashers over power-of-two bucket counts (the low bits of the hash select the
+ *  bucket), then throughput of the byte-string hashes over strings of several lengths (short strings take the tail
+ *  loop only, 32 bytes and up go through the four-lane loop). Run with an optional key count (rounded up to a power of
+ *  two) and seed: hash_bench.out [keys] [seed] */
+
+#define ROUNDS 16
+#define STRING_BYTES (1 << 20)
+
+typedef struct hasher_entry
+{
+	const char* name;
+	table_hasher_t hasher;
+} hasher_entry;
+
+typedef struct key_set
+{
+	const char* name;
+	size_t stride; /* 0 for random keys */
+} key_set;
+
+static size_t identity_hasher(const table_key_t* key, uint64_t seed);
+static void fill_keys(table_key_t* keys, size_t n, const key_set* set, uint64_t seed);
+static void report(const hasher_entry* hasher, const key_set* set, const table_key_t* keys, size_t n,
+	size_t* buckets, size_t bucket_count, uint64_t seed);
+static void report_strings(const unsigned char* data, size_t length, uint64_t seed);
+
+int main(int argc, char** argv)
+{
+	static const hasher_entry hashers[] = {
+		{ "identity", identity_hasher },
+		{ "mix", table_hash_mix },
+		{ "bytes", table_hash_key_bytes },
+		{ "sip", table_hash_sip }
+	};
+
+	static const key_set sets[] = {
+		{ "sequential", 1 },
+		{ "stride-64", 64 },
+		{ "stride-4096", 4096 },
+		{ "random", 0 }
+	};
+
+	static const size_t lengths[] = { 4, 8, 16, 31, 32, 64, 256, 4096 };
+
+	size_t n = 1;
+	size_t requested = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 1 << 16;
+	uint64_t seed = argc > 2 ? (uint64_t)strtoull(argv[2], NULL, 10) : 0x5EED;
+	size_t bucket_count;
+	table_key_t* keys;
+	size_t* buckets;
+	unsigned char* strings;
+	uint64_t state = seed | 1;
+	size_t i, j;
+
+	while (n < requested)
+		n <<= 1;
+
+	bucket_count = n * 2; /* load factor 0.5 */
+	keys = (table_key_t*)malloc(n * sizeof(table_key_t));
+	buckets = (size_t*)malloc(bucket_count * sizeof(size_t));
+	strings = (unsigned char*)malloc(STRING_BYTES);
+
+	if (!keys || !buckets || !strings)
+	{
+		printf("Allocation failed.\n");
+		return 1;
+	}
+
+	printf("%zu keys, %zu buckets, seed %llu\n", n, bucket_count, (unsigned long long)seed);
+	printf("%-12s %-10s %10s %10s %8s %10s %9s\n",
+		"keys", "hasher", "collisions", "expected", "max", "chi2/df", "ns/hash");
+
+	for (i = 0; i < sizeof(sets)/sizeof(sets[0]); ++i)
+	{
+		fill_keys(keys, n, &sets[i], seed);
+
+		for (j = 0; j < sizeof(hashers)/sizeof(hashers[0]); ++j)
+			report(&hashers[j], &sets[i], keys, n, buckets, bucket_count, seed);
+	}
+
+	for (i = 0; i < STRING_BYTES; ++i)
+		strings[i] = (unsigned char)bench_xorshift64(&state);
+
+	printf("\n%-12s %-10s %9s %9s\n", "string", "hasher", "ns/hash", "GB/s");
+
+	for (i = 0; i < sizeof(lengths)/sizeof(lengths[0]); ++i)
+		report_strings(strings, lengths[i], seed);
+
+	free(keys);
+	free(buckets);
+	free(strings);
+	return 0;
+}
+
+static size_t identity_hasher(const table_key_t* key, uint64_t seed)
+{
+	(void)seed;
+	return (size_t)*key;
+}
+
+static void fill_keys(table_key_t* keys, size_t n, const key_set* set, uint64_t seed)
+{
+	uint64_t state = seed | 1;
+	size_t i;
+
+	for (i = 0; i < n; ++i)
+		keys[i] = set->stride ? (table_key_t)(i * set->stride) : (table_key_t)bench_xorshift64(&state);
+}
+
+static void report(const hasher_entry* hasher, const key_set* set, const table_key_t* keys, size_t n,
+	size_t* buckets, size_t bucket_count, uint64_t seed)
+{
+	size_t mask = bucket_count - 1;
+	size_t occupied = 0;
+	size_t max = 0;
+	volatile size_t sink = 0; /* keeps the timed loop from being optimized out */
+	double mean = (double)n / bucket_count;
+	double expected_empty = 1.0;
+	double chi2 = 0.0;
+	clock_t start;
+	double elapsed;
+	size_t i;
+	int round;
+
+	for (i = 0; i < bucket_count; ++i)
+		buckets[i] = 0;
+
+	for (i = 0; i < n; ++i)
+		buckets[hasher->hasher(&keys[i], seed) & mask] += 1;
+
+	for (i = 0; i < bucket_count; ++i)
+	{
+		double diff = buckets[i] - mean;
+
+		occupied += buckets[i] != 0;
+		max = buckets[i] > max ? buckets[i] : max;
+		chi2 += diff*diff / mean;
+	}
+
+	/* a uniformly random hash leaves bucket_count * (1 - 1/bucket_count)^n buckets empty */
+	for (i = 0; i < n; ++i)
+		expected_empty *= 1.0 - 1.0 / bucket_count;
+
+	start = clock();
+
+	for (round = 0; round < ROUNDS; ++round)
+		for (i = 0; i < n; ++i)
+			sink += hasher->hasher(&keys[i], seed);
+
+	elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	printf("%-12s %-10s %10zu %10.0f %8zu %10.3f %9.2f\n", set->name, hasher->name, n - occupied,
+		n - bucket_count * (1.0 - expected_empty), max, chi2 / (bucket_count - 1),
+		elapsed * 1e9 / ((double)n * ROUNDS));
+}
+
+static void report_strings(const unsigned char* data, size_t length, uint64_t seed)
+{
+	size_t count = STRING_BYTES / length;
+	volatile uint64_t sink = 0; /* keeps the timed loops from being optimized out */
+	char name[16];
+	double start;
+	double elapsed[2];
+	size_t i;
+	int round;
+
+	/* consecutive strings of the buffer, so the input stays cache-resident across rounds */
+	start = bench_now();
+
+	for (round = 0; round < ROUNDS; ++round)
+		for (i = 0; i < count; ++i)
+			sink += table_hash_bytes(data + i * length, length, seed);
+
+	elapsed[0] = bench_now() - start;
+	start = bench_now();
+
+	for (round = 0; round < ROUNDS; ++round)
+		for (i = 0; i < count; ++i)
+			sink += table_siphash(data + i * length, length, seed, ~seed);
+
+	elapsed[1] = bench_now() - start;
+
+	snprintf(name, sizeof(name), "%zu bytes", length);
+	printf("%-12s %-10s %9.2f %9.2f\n", name, "xxh64", elapsed[0] * 1e9 / ((double)count * ROUNDS),
+		(double)count * length * ROUNDS / elapsed[0] / 1e9);
+	printf("%-12s %-10s %9.2f %9.2f\n", name, "siphash", elapsed[1] * 1e9 / ((double)count * ROUNDS),
+		(double)count * length * ROUNDS / elapsed[1] / 1e9);
+}
@@ -0,0 +1,33 @@
+#include <stdlib.h>
+#include "int_map.h"
+
+/* Integer map interface implementation */
+
+void int_map_init(int_map_t* map, const table_config_t* config);
+
+void int_map_free(int_map_t* map);
+
+void int_map_clear(int_map_t* map);
+
+size_t int_map_size(const int_map_t* map);
+
+int_map_iter_t int_map_insert(int_map_t* map, table_key_t key, table_value_t value);
+
+int_map_iter_t int_map_erase(int_map_t* map, int_map_iter_t iter);
+
+const table_key_t* int_map_key(const int_map_t* map, int_map_const_iter_t iter);
+
+const table_value_t* int_map_value(const int_map_t* map, int_map_const_iter_t iter);
+
+int_map_iter_t int_map_assign(int_map_t* map, int_map_iter_t iter, table_value_t value);
+
+int_map_const_iter_t int_map_find(const int_map_t* map, table_key_t key);
+int_map_iter_t int_map_find_mut(int_map_t* map, table_key_t key);
+
+int_map_const_iter_t int_map_begin(const int_map_t* map);
+int_map_iter_t int_map_begin_mut(int_map_t* map);
+
+int_map_const_iter_t int_map_end(const int_map_t* map);
+
+int_map_const_iter_t int_map_next(const int_map_t* map, int_map_const_iter_t iter);
+int_map_iter_t int_map_next_mut(const int_map_t* map, int_map_iter_t iter);
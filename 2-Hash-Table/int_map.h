@@ -0,0 +1,176 @@
+#pragma once
+
+#include <limits.h>
+#include <stddef.h>
+#include "table.h"
+
+/**
+ * The int_map_t type implements a hash table specialized for integral table_key_t and table_value_t (the default
+ *  int -> int configuration of table.h) with no per-entry pointers.
+ *
+ * Implementation-defined specification:
+ *   int_map_slot_t: Entry structure type definition.
+ *   int_map_t: Integer map structure type definition.
+ *
+ * Expectations:
+ *   Entries are stored flat as (key, value) pairs in a power-of-two slot array with linear probing, a slot whose key is
+ *    INT_MAP_EMPTY_KEY is empty. Inserting INT_MAP_EMPTY_KEY is a failure.
+ *   There are no storage modes: keys and values are copied into the slots and own no memory, so key_duplicator,
+ *    key_destructor, value_duplicator, and value_destructor are never called.
+ *   Erasure uses backward-shift deletion, so there are no tombstones and a lookup stops at the first empty slot.
+ *   The load factor does not exceed 7/8 and the slot array doubles when it would, so right after a doubling the load
+ *    factor is 7/16. Memory per entry thus stays between 8/7 and 16/7 * sizeof(int_map_slot_t) once the map holds
+ *    entries.
+ *   Iterators mirror the table_* iterator API (int_map_begin, int_map_next, int_map_end, int_map_key, int_map_value)
+ *    so code written against table_t ports by renaming, int_map_key and int_map_value return pointers like table_key
+ *    and table_value.
+ *   Int map slots are not to be accessed or manipulated outside the interface.
+ *
+ * All functions aside from int_map_init expect an initialized map, providing an uninitialized map shall be undefined
+ *  behavior.
+ * The function int_map_init expects an uninitialized map, providing an initialized map shall be undefined behavior.
+ * Passing iterators to functions that are invalidated (from inserting, removing, rehashing, etc.) shall be undefined
+ *  behavior.
+ */
+
+#define INT_MAP_EMPTY_KEY INT_MIN
+
+typedef struct int_map_slot_t
+{
+	table_key_t key;
+	table_value_t value;
+} int_map_slot_t;
+
+typedef int_map_slot_t* int_map_iter_t;
+typedef const int_map_slot_t* int_map_const_iter_t;
+
+typedef struct int_map_t
+{
+	/* implementation defined, use int_map_slot_t for entries */
+} int_map_t;
+
+/**
+ * Initializes the given map.
+ * @param map A pointer to an uninitialized map.
+ * @param config A pointer to a configuration whose hasher and seed are used (other options are ignored), NULL for
+ *  the default.
+ */
+void int_map_init(int_map_t* map, const table_config_t* config);
+
+/**
+ * Releases resources used by the given map.
+ * The map will become in an uninitialized state after this call.
+ * @param map A pointer to an initialized map.
+ */
+void int_map_free(int_map_t* map);
+
+/**
+ * Clears all entries of the given map.
+ * @param map A pointer to an initialized map.
+ */
+void int_map_clear(int_map_t* map);
+
+/**
+ * Returns the number of entries in the given map.
+ * @param map A pointer to an initialized map.
+ * @return The number of entries (key-value pairs) residing in the map.
+ */
+size_t int_map_size(const int_map_t* map);
+
+/**
+ * Inserts a key-value pair into the map.
+ * If the key already exists in the map or is INT_MAP_EMPTY_KEY, the insertion is a failure.
+ * @param map A pointer to an initialized map.
+ * @param key The key.
+ * @param value The value.
+ * @return The iterator of the newly inserted entry, int_map_end(map) on failure.
+ */
+int_map_iter_t int_map_insert(int_map_t* map, table_key_t key, table_value_t value);
+
+/**
+ * Erases a key-value pair from the map.
+ * Entries following the erased one in its probe sequence may be shifted back into its slot.
+ * @param map A pointer to an initialized map.
+ * @param iter A valid iterator excluding int_map_end(map) to the entry to remove.
+ * @return iter if an entry was shifted into its slot, the iterator of the next entry otherwise, int_map_end(map) if
+ *  at end. An entry shifted from the start of the slot array to its end is visited again by an ongoing iteration.
+ */
+int_map_iter_t int_map_erase(int_map_t* map, int_map_iter_t iter);
+
+/**
+ * Returns the key associated with an iterator.
+ * @param map A pointer to an initialized map.
+ * @param iter A valid iterator excluding int_map_end(map) to the entry to access.
+ * @return A pointer to the key associated with the iterator.
+ */
+const table_key_t* int_map_key(const int_map_t* map, int_map_const_iter_t iter);
+
+/**
+ * Returns the value associated with an iterator.
+ * @param map A pointer to an initialized map.
+ * @param iter A valid iterator excluding int_map_end(map) to the entry to access.
+ * @return A pointer to the value associated with the iterator.
+ */
+const table_value_t* int_map_value(const int_map_t* map, int_map_const_iter_t iter);
+
+/**
+ * Assigns a new value to the iterator.
+ * @param map A pointer to an initialized map.
+ * @param iter A valid iterator excluding int_map_end(map) to the entry to mutate.
+ * @param value The new value.
+ * @return The iterator passed to the function.
+ */
+int_map_iter_t int_map_assign(int_map_t* map, int_map_iter_t iter, table_value_t value);
+
+/**
+ * Returns the iterator associated to an entry.
+ * @param map A pointer to an initialized map.
+ * @param key The key.
+ * @return The iterator of the entry if found, int_map_end(map) on failure.
+ */
+int_map_const_iter_t int_map_find(const int_map_t* map, table_key_t key);
+
+/**
+ * Returns the mutable iterator associated to an entry.
+ * @param map A pointer to an initialized map.
+ * @param key The key.
+ * @return The iterator of the entry if found, int_map_end(map) on failure.
+ */
+int_map_iter_t int_map_find_mut(int_map_t* map, table_key_t key);
+
+/**
+ * Returns the iterator associated to the first entry in a map.
+ * @param map A pointer to an initialized map.
+ * @return The iterator of the first entry, int_map_end(map) on empty map.
+ */
+int_map_const_iter_t int_map_begin(const int_map_t* map);
+
+/**
+ * Returns the mutable iterator associated to the first entry in a map.
+ * @param map A pointer to an initialized map.
+ * @return The iterator of the first entry, int_map_end(map) on empty map.
+ */
+int_map_iter_t int_map_begin_mut(int_map_t* map);
+
+/**
+ * Returns the iterator associated to the end of a map.
+ * @param map A pointer to an initialized map.
+ * @return One past the last slot of the slot array.
+ */
+int_map_const_iter_t int_map_end(const int_map_t* map);
+
+/**
+ * Returns the iterator proceeding a given iterator, skipping empty slots.
+ * @param map A pointer to an initialized map.
+ * @param iter A valid iterator excluding int_map_end(map) to the entry.
+ * @return The iterator proceeding the given iterator, int_map_end(map) on end reached.
+ */
+int_map_const_iter_t int_map_next(const int_map_t* map, int_map_const_iter_t iter);
+
+/**
+ * Returns the mutable iterator proceeding a given iterator, skipping empty slots.
+ * @param map A pointer to an initialized map.
+ * @param iter A valid iterator excluding int_map_end(map) to the entry.
+ * @return The iterator proceeding the given iterator, int_map_end(map) on end reached.
+ */
+int_map_iter_t int_map_next_mut(const int_map_t* map, int_map_iter_t iter);
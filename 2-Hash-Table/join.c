@@ -0,0 +1,20 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include "join.h"
+
+/* Join interface implementation */
+
+void join_init(join_t* join, join_mode_t mode, const table_config_t* config);
+
+void join_free(join_t* join);
+
+int join_build(join_t* join, const join_row_t* rows, size_t n);
+
+size_t join_build_size(const join_t* join);
+
+int join_cursor_init(join_t* join, join_cursor_t* cursor, const join_row_t* rows, size_t n);
+
+size_t join_probe(join_t* join, join_cursor_t* cursor, join_match_t* out, size_t capacity);
+
+size_t join_probe_parallel(join_t* join, const join_row_t* rows, size_t n, size_t threads, join_match_t* buffers,
+	size_t capacity, join_sink_t sink, void* context);
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <stddef.h>
+#include "table.h"
+
+/**
+ * The join_t type implements an equi-join of two keyed row sets: the build side is indexed by key, then rows of the
+ *  probe side are matched against it.
+ *
+ * Implementation-defined specification:
+ *   join_t: Join structure type definition.
+ *   join_cursor_t: Probe position structure type definition.
+ *
+ * Expectations:
+ *   Rows carry a key and an opaque payload (typically a row index), matches are emitted as (build payload, probe
+ *    payload) pairs into buffers supplied by the caller, there is no allocation per row or per match.
+ *   join_build sizes the index once for all build rows and then inserts them in a single pass that never grows it.
+ *    Build rows sharing a key are all kept (chained under one index entry, unlike table_insert_bulk which rejects
+ *    duplicate keys), and a probe row matches every one of them.
+ *   Probing is done in batches of JOIN_BATCH rows: the keys of a batch are hashed together and their slots are
+ *    prefetched before any is compared (see table_find_batch).
+ *   JOIN_RADIX first scatters the build rows, then the probe rows, by the high bits of their hash (the radix) into
+ *    partitions whose index fits the last-level cache, and joins partition by partition. The scatter buffers are
+ *    owned by the join and reused across probes. The order of emitted matches is implementation-defined for both
+ *    modes.
+ *   join_probe_parallel splits the probe rows (JOIN_DEFAULT) or the partitions (JOIN_RADIX) between threads, every
+ *    thread emitting into its own caller-supplied buffer. Threads are POSIX threads.
+ *   Keys are copied, so key_duplicator and key_destructor are never called.
+ *
+ * All functions aside from join_init expect an initialized join, providing an uninitialized join shall be undefined
+ *  behavior.
+ * The function join_init expects an uninitialized join, providing an initialized join shall be undefined behavior.
+ * A cursor is valid from join_cursor_init until the build side is replaced or another cursor of the same join is
+ *  initialized. Passing an invalid cursor to functions shall be undefined behavior.
+ */
+
+#define JOIN_BATCH 64
+
+typedef enum join_mode_t
+{
+	JOIN_DEFAULT, JOIN_RADIX
+} join_mode_t;
+
+typedef struct join_row_t
+{
+	table_key_t key;
+	size_t payload;
+} join_row_t;
+
+typedef struct join_match_t
+{
+	size_t build;
+	size_t probe;
+} join_match_t;
+
+typedef struct join_t
+{
+	/* implementation defined */
+} join_t;
+
+typedef struct join_cursor_t
+{
+	/* implementation defined */
+} join_cursor_t;
+
+/**
+ * Receives a full buffer of matches from join_probe_parallel.
+ * @param matches The matches, valid until the callback returns.
+ * @param count The number of matches.
+ * @param thread The index of the calling thread, from 0 to threads - 1.
+ * @param context The context passed to join_probe_parallel.
+ */
+typedef void (*join_sink_t)(const join_match_t* matches, size_t count, size_t thread, void* context);
+
+/**
+ * Initializes the given join with an empty build side.
+ * @param join A pointer to an uninitialized join.
+ * @param mode The join strategy.
+ * @param config A pointer to a configuration whose hasher and seed are used (other options are ignored), NULL for
+ *  the default.
+ */
+void join_init(join_t* join, join_mode_t mode, const table_config_t* config);
+
+/**
+ * Releases resources used by the given join.
+ * The join will become in an uninitialized state after this call.
+ * @param join A pointer to an initialized join.
+ */
+void join_free(join_t* join);
+
+/**
+ * Indexes the build side of the join, replacing any previous build side.
+ * @param join A pointer to an initialized join.
+ * @param rows An array of n build rows, only read during the call.
+ * @param n The number of rows.
+ * @return 1 on success, 0 on allocation failure leaving the join with an empty build side.
+ */
+int join_build(join_t* join, const join_row_t* rows, size_t n);
+
+/**
+ * Returns the number of rows of the build side.
+ * @param join A pointer to an initialized join.
+ * @return The number of rows passed to the last successful join_build, 0 if none.
+ */
+size_t join_build_size(const join_t* join);
+
+/**
+ * Starts a probe of the given rows against the build side.
+ * @param join A pointer to an initialized join.
+ * @param cursor A pointer to the cursor to start.
+ * @param rows An array of n probe rows, which must remain unchanged until the cursor is exhausted.
+ * @param n The number of rows.
+ * @return 1 on success, 0 on allocation failure of the JOIN_RADIX scatter buffers.
+ */
+int join_cursor_init(join_t* join, join_cursor_t* cursor, const join_row_t* rows, size_t n);
+
+/**
+ * Emits the next matches of a probe into a buffer, resuming where the previous call stopped.
+ * @param join A pointer to an initialized join.
+ * @param cursor A valid cursor of the join.
+ * @param out An array receiving up to capacity matches.
+ * @param capacity The capacity of out, at least 1.
+ * @return The number of matches written, 0 once every match has been emitted.
+ */
+size_t join_probe(join_t* join, join_cursor_t* cursor, join_match_t* out, size_t capacity);
+
+/**
+ * Probes the given rows against the build side using multiple threads.
+ * Every thread fills its own buffer and passes it to the sink whenever it is full and once more at the end if it is
+ *  not empty, so the sink is called concurrently with distinct thread indices.
+ * @param join A pointer to an initialized join.
+ * @param rows An array of n probe rows.
+ * @param n The number of rows.
+ * @param threads The number of threads, 0 selects the number of online processors (only allowed when buffers is NULL,
+ *  since the caller could not size them).
+ * @param buffers An array of threads * capacity matches, thread i uses buffers[i * capacity] onwards; NULL makes
+ *  the join allocate the buffers once for the call.
+ * @param capacity The capacity of each thread's buffer, at least 1.
+ * @param sink The callback receiving the matches.
+ * @param context The context passed to the callback.
+ * @return The total number of matches, (size_t)-1 on failure to allocate or to create the threads, in which case some
+ *  matches may have been emitted, or if threads is 0 while buffers is not NULL, in which case nothing is emitted.
+ */
+size_t join_probe_parallel(join_t* join, const join_row_t* rows, size_t n, size_t threads, join_match_t* buffers,
+	size_t capacity, join_sink_t sink, void* context);
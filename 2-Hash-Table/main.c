@@ -1,6 +1,14 @@
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "table.h"
+#include "string_table.h"
+#include "sharded_table.h"
+#include "int_map.h"
+#include "cache.h"
+#include "aggregate.h"
+#include "join.h"
 
 #define TEST(expr) TEST_IMPL(expr, #expr, __LINE__)
 
@@ -18,6 +26,13 @@ else \
 
 static table_key_t* key_new(table_key_t key);
 static table_value_t* value_new(table_value_t value);
+static void sum_entries(const table_t* shard, table_const_iter_t iter, void* context);
+static void* concurrent_reader(void* context);
+static int readers_stopped(void);
+static void check_matches(const join_match_t* matches, size_t count, size_t thread, void* context);
+
+static pthread_mutex_t readers_lock = PTHREAD_MUTEX_INITIALIZER;
+static int readers_stop = 0; // guarded by readers_lock
 
 int main(void)
 {
@@ -60,6 +75,13 @@ int main(void)
 		TEST(iter != table_end(table));
 		TEST(table_key(table, iter) == k);
 		TEST(table_value(table, iter) != v);
+		TEST(*table_value(table, iter) == 200);
+
+		if (TABLE_INLINE_VALUE) // TRANSIENT small values live inside the node
+		{
+			TEST((const char*)table_value(table, iter) >= (const char*)iter);
+			TEST((const char*)table_value(table, iter) < (const char*)(iter + 1));
+		}
 
 		free(v); // k is no longer user-managed
 
@@ -79,6 +101,980 @@ int main(void)
 		TEST(table_erase(table, iter));
 	}
 
+	{
+		table_key_t keys[4] = { 1, 2, 1, 3 };
+		table_value_t values[4] = { 10, 20, 30, 40 };
+		table_key_t* key_ptrs[4] = { &keys[0], &keys[1], &keys[2], &keys[3] };
+		table_value_t* value_ptrs[4] = { &values[0], &values[1], &values[2], &values[3] };
+		const table_key_t* find_ptrs[3];
+		table_key_t missing = 4;
+		table_iter_t inserted[4];
+		table_const_iter_t found[3];
+
+		table_clear(table);
+		table_insert_batch(table, key_ptrs, value_ptrs, 4, TRANSIENT, TRANSIENT, inserted);
+		TEST(table_size(table) == 3);
+		TEST(inserted[0] != table_end(table));
+		TEST(inserted[1] != table_end(table));
+		TEST(inserted[2] == table_end(table)); // duplicate of keys[0] within the batch
+		TEST(inserted[3] != table_end(table));
+
+		find_ptrs[0] = &keys[3];
+		find_ptrs[1] = &missing;
+		find_ptrs[2] = &keys[0];
+		table_find_batch(table, find_ptrs, 3, found);
+		TEST(found[0] == inserted[3]);
+		TEST(found[1] == table_end(table));
+		TEST(found[2] == inserted[0]);
+		TEST(*table_value(table, found[2]) == 10);
+
+		table_clear(table);
+	}
+
+	{
+		table_key_t words[8] = { 3, 1, 3, 2, 3, 1, 9, 3 };
+		table_iter_t iter;
+		int inserted;
+		int i;
+
+		table_clear(table);
+
+		for (i = 0; i < 8; ++i)
+		{
+			iter = table_find_or_insert(table, &words[i], TRANSIENT, &inserted);
+			TEST(inserted == (i == 0 || i == 1 || i == 3 || i == 6));
+			*table_value_mut(table, iter) += 1;
+		}
+
+		TEST(table_size(table) == 4);
+		TEST(*table_value(table, table_find(table, &words[0])) == 4);
+		TEST(*table_value(table, table_find(table, &words[1])) == 2);
+		TEST(*table_value(table, table_find(table, &words[6])) == 1);
+
+		iter = table_upsert(table, &words[0], value_new(40), TRANSIENT, TRANSFER, &inserted);
+		TEST(!inserted);
+		TEST(*table_value(table, iter) == 40);
+		iter = table_upsert(table, &words[0], &words[1], TRANSIENT, STATIC, NULL); // releases the TRANSFER value
+		TEST(table_value(table, iter) == &words[1]);
+		iter = table_upsert(table, key_new(7), value_new(70), TRANSFER, TRANSFER, &inserted);
+		TEST(inserted);
+		TEST(table_size(table) == 5);
+
+		{
+			table_key_t* duplicate = key_new(7);
+
+			iter = table_upsert(table, duplicate, value_new(71), TRANSFER, TRANSFER, &inserted);
+			TEST(!inserted);
+			TEST(*table_value(table, iter) == 71);
+			TEST(table_key(table, iter) != duplicate);
+			free(duplicate); // a TRANSFER key that was not taken stays with the caller
+		}
+
+		table_clear(table);
+	}
+
+	{
+		table_config_t config = { 0 };
+		table_t _seeded;
+		table_t* seeded = &_seeded;
+		table_key_t k = 42;
+		table_value_t v = 4200;
+
+		TEST(table_hash_bytes("", 0, 0) == UINT64_C(0xEF46DB3751D8E999));
+		TEST(table_siphash("", 0, UINT64_C(0x0706050403020100), UINT64_C(0x0F0E0D0C0B0A0908))
+			== UINT64_C(0x726FDB47DD0E0E31));
+		TEST(table_hash_mix(&k, 1) != table_hash_mix(&k, 2));
+
+		config.hasher = table_hash_sip;
+		config.seed = UINT64_C(0x243F6A8885A308D3);
+		table_init_config(seeded, &config);
+		TEST(table_insert(seeded, &k, &v, STATIC, STATIC) != table_end(seeded));
+		TEST(table_find(seeded, &k) != table_end(seeded));
+		TEST(*table_value(seeded, table_find(seeded, &k)) == 4200);
+		table_free(seeded);
+	}
+
+	{
+		table_key_t keys[64];
+		table_key_t k;
+		table_const_iter_t iter;
+		size_t count = 0;
+		size_t found = 0;
+		int i;
+
+		table_clear(table);
+
+		for (i = 0; i < 64; ++i)
+		{
+			keys[i] = i * 7;
+			table_insert(table, &keys[i], &keys[i], TRANSIENT, TRANSIENT);
+		}
+
+		TEST(!table_frozen(table));
+		TEST(table_freeze(table));
+		TEST(table_frozen(table));
+		TEST(table_size(table) == 64);
+
+		for (i = 0; i < 64; ++i)
+		{
+			iter = table_find(table, &keys[i]);
+			found += iter != table_end(table) && *table_value(table, iter) == keys[i];
+		}
+
+		TEST(found == 64);
+
+		k = 1;
+		TEST(table_find(table, &k) == table_end(table));
+		TEST(table_insert(table, &k, &k, TRANSIENT, TRANSIENT) == table_end(table));
+		TEST(table_find_or_insert(table, &k, TRANSIENT, NULL) == table_end(table));
+		TEST(!table_reserve(table, 1000));
+		TEST(!table_shrink_to_fit(table));
+		TEST(table_size(table) == 64);
+
+		for (iter = table_begin(table); iter != table_end(table); iter = table_next(table, iter))
+			count += 1;
+
+		TEST(count == 64);
+
+		table_clear(table);
+		TEST(!table_frozen(table));
+	}
+
+	{
+		table_config_t config = { 0 };
+		table_t _dense;
+		table_t* dense = &_dense;
+		table_key_t keys[5] = { 50, 10, 40, 20, 30 };
+		table_key_t expected[4] = { 50, 10, 20, 30 };
+		table_iter_t iter;
+		size_t in_order = 0;
+		int i;
+
+		config.layout = TABLE_LAYOUT_DENSE;
+		table_init_config(dense, &config);
+
+		for (i = 0; i < 5; ++i)
+			table_insert(dense, &keys[i], &keys[i], TRANSIENT, TRANSIENT);
+
+		for (i = 0, iter = table_begin_mut(dense); iter != table_end(dense); ++i, iter = table_next_mut(dense, iter))
+			in_order += *table_key(dense, iter) == keys[i];
+
+		TEST(in_order == 5);
+
+		iter = table_find_mut(dense, &keys[2]);
+		TEST(table_erase(dense, iter) == iter + 1); // 40 leaves a hole, the next live entry is 20
+		TEST(table_size(dense) == 4);
+		TEST(table_next(dense, table_begin(dense)) == table_begin(dense) + 1);
+		TEST(table_next(dense, table_begin(dense) + 1) == table_begin(dense) + 3); // skips the hole
+		TEST(table_end(dense) == table_begin(dense) + 5); // holes are only compacted by a rehash
+
+		for (i = 0, in_order = 0, iter = table_begin_mut(dense); iter != table_end(dense);
+			++i, iter = table_next_mut(dense, iter))
+			in_order += *table_key(dense, iter) == expected[i];
+
+		TEST(in_order == 4);
+
+		iter = table_find_mut(dense, &keys[4]);
+		TEST(table_erase(dense, iter) == table_end(dense)); // erasing the last entry
+		table_free(dense);
+	}
+
+	{
+		table_t _mapped;
+		table_t* mapped = &_mapped;
+		table_key_t k;
+		table_value_t v;
+		table_const_iter_t iter;
+		size_t found = 0;
+
+		table_clear(table);
+
+		for (k = 0; k < 100; ++k)
+		{
+			v = k * k;
+			table_insert(table, &k, &v, TRANSIENT, TRANSIENT);
+		}
+
+		TEST(table_save(table, "table_image.bin"));
+		TEST(table_open_mmap(mapped, "table_image.bin", NULL));
+		TEST(table_size(mapped) == 100);
+		TEST(table_frozen(mapped));
+
+		for (k = 0; k < 100; ++k)
+		{
+			iter = table_find(mapped, &k);
+			found += iter != table_end(mapped) && *table_value(mapped, iter) == k * k;
+		}
+
+		TEST(found == 100);
+		TEST(table_insert(mapped, &k, &v, TRANSIENT, TRANSIENT) == table_end(mapped));
+		TEST(!table_reserve(mapped, 1000));
+
+		table_free(mapped);
+		remove("table_image.bin");
+		TEST(!table_open_mmap(mapped, "table_image.bin", NULL));
+		table_clear(table);
+	}
+
+	{
+		table_key_t keys[6] = { 1, 2, 3, 2, 7, 1 };
+		table_value_t values[6] = { 10, 20, 30, 40, 70, 50 };
+		table_key_t* key_ptrs[6];
+		table_value_t* value_ptrs[6];
+		size_t duplicates[6];
+		table_key_t existing = 7;
+		int i;
+
+		for (i = 0; i < 6; ++i)
+		{
+			key_ptrs[i] = &keys[i];
+			value_ptrs[i] = &values[i];
+		}
+
+		table_clear(table);
+		TEST(table_reserve(table, 1000));
+		TEST(table_insert(table, &existing, &existing, TRANSIENT, TRANSIENT) != table_end(table));
+
+		TEST(table_insert_bulk(table, key_ptrs, value_ptrs, 6, TRANSIENT, TRANSIENT, duplicates) == 3);
+		TEST(duplicates[0] == 3 && duplicates[1] == 4 && duplicates[2] == 5);
+		TEST(table_size(table) == 4);
+		TEST(*table_value(table, table_find(table, &keys[1])) == 20); // first occurrence wins
+		TEST(*table_value(table, table_find(table, &existing)) == 7);
+		TEST(table_insert_bulk(table, key_ptrs, value_ptrs, 6, TRANSIENT, TRANSIENT, NULL) == 6);
+
+		table_clear(table);
+	}
+
+	{
+		string_table_t _strings;
+		string_table_t* strings = &_strings;
+		const char* long_key = "a key well beyond the inline limit";
+		char buffer[] = "apple pie";
+		table_value_t v = 1;
+		string_table_const_iter_t iter;
+		size_t length;
+
+		string_table_init(strings, 0);
+		TEST(string_table_insert(strings, "apple", 5, &v, TRANSIENT) != string_table_end(strings));
+		TEST(string_table_insert(strings, long_key, strlen(long_key), &v, TRANSIENT) != string_table_end(strings));
+		TEST(string_table_insert(strings, buffer, 5, &v, TRANSIENT) == string_table_end(strings)); // "apple" again
+
+		if (SIZE_MAX > STRING_TABLE_MAX_KEY) // rejected on length alone, the bytes are never read
+		{
+			TEST(string_table_insert(strings, buffer, (size_t)STRING_TABLE_MAX_KEY + 1, &v, TRANSIENT)
+				== string_table_end(strings));
+		}
+
+		TEST(string_table_size(strings) == 2);
+
+		iter = string_table_find(strings, buffer, 5); // lookup by a prefix of a larger buffer
+		TEST(iter != string_table_end(strings));
+		TEST(strcmp(string_table_key(strings, iter, &length), "apple") == 0);
+		TEST(length == 5);
+		TEST(string_table_key(strings, iter, NULL) != buffer);
+
+		iter = string_table_find(strings, long_key, strlen(long_key));
+		TEST(iter != string_table_end(strings));
+		TEST(string_table_key(strings, iter, NULL) != long_key);
+		TEST(string_table_find(strings, buffer, strlen(buffer)) == string_table_end(strings));
+		TEST(string_table_find(strings, "apple", 4) == string_table_end(strings));
+
+		string_table_free(strings);
+	}
+
+	{
+		table_config_t config = { 0 };
+		table_t _cuckoo;
+		table_t* cuckoo = &_cuckoo;
+		table_key_t k;
+		size_t inserted = 0;
+		size_t found = 0;
+
+		config.engine = TABLE_ENGINE_CUCKOO;
+		config.cuckoo_slots = 8;
+		table_init_config(cuckoo, &config);
+
+		for (k = 0; k < 10000; ++k)
+			inserted += table_insert(cuckoo, &k, &k, TRANSIENT, TRANSIENT) != table_end(cuckoo);
+
+		TEST(inserted == 10000);
+		TEST(table_size(cuckoo) == 10000);
+
+		k = 1234;
+		TEST(table_insert(cuckoo, &k, &k, TRANSIENT, TRANSIENT) == table_end(cuckoo));
+
+		for (k = 0; k < 20000; ++k)
+			found += table_find(cuckoo, &k) != table_end(cuckoo);
+
+		TEST(found == 10000);
+
+		k = 4321;
+		table_erase(cuckoo, table_find_mut(cuckoo, &k));
+		TEST(table_find(cuckoo, &k) == table_end(cuckoo));
+		TEST(table_size(cuckoo) == 9999);
+
+		table_free(cuckoo);
+	}
+
+	{
+		sharded_table_t _sharded;
+		sharded_table_t* sharded = &_sharded;
+		table_key_t keys[1000];
+		table_key_t* key_ptrs[1000];
+		sharded_table_iter_t iter;
+		sharded_table_const_iter_t found;
+		size_t count = 0;
+		long long sum = 0;
+		size_t matched = 0;
+		int i;
+
+		TEST(sharded_table_init(sharded, 8, 4, NULL));
+		TEST(sharded_table_shard_count(sharded) == 8);
+
+		for (i = 0; i < 1000; ++i)
+		{
+			keys[i] = i;
+			key_ptrs[i] = &keys[i];
+		}
+
+		TEST(sharded_table_insert_bulk(sharded, key_ptrs, key_ptrs, 1000, TRANSIENT, TRANSIENT, NULL) == 0);
+		TEST(sharded_table_size(sharded) == 1000);
+
+		for (i = 0; i < 1000; ++i)
+		{
+			found = sharded_table_find(sharded, &keys[i]);
+			matched += found.shard == sharded_table_route(sharded, &keys[i])
+				&& !sharded_table_const_iter_equal(found, sharded_table_cend(sharded));
+		}
+
+		TEST(matched == 1000);
+		TEST(sharded_table_iter_equal(sharded_table_insert(sharded, &keys[0], &keys[0], TRANSIENT, TRANSIENT),
+			sharded_table_end(sharded)));
+
+		for (iter = sharded_table_begin(sharded); !sharded_table_iter_equal(iter, sharded_table_end(sharded));
+			iter = sharded_table_next(sharded, iter))
+			count += 1;
+
+		TEST(count == 1000);
+
+		sharded_table_foreach(sharded, sum_entries, &sum);
+		TEST(sum == 999 * 1000 / 2);
+
+		sharded_table_clear(sharded);
+		TEST(sharded_table_size(sharded) == 0);
+		sharded_table_free(sharded);
+	}
+
+	{
+		table_config_t config = { 0 };
+		table_t _shared;
+		table_t* shared = &_shared;
+		table_reader_t reader;
+		table_const_iter_t iter;
+		pthread_t thread;
+		void* misses;
+		table_key_t k;
+		int started;
+
+		config.concurrency = TABLE_CONCURRENCY_EPOCH;
+		table_init_config(shared, &config);
+
+		k = 0;
+		table_insert(shared, &k, &k, TRANSIENT, TRANSIENT);
+
+		TEST(table_reader_register(shared, &reader));
+		table_read_begin(shared, &reader);
+		iter = table_find(shared, &k);
+		table_erase(shared, table_find_mut(shared, &k)); // writer retires the node
+		TEST(*table_value(shared, iter) == 0); // still readable inside the critical section
+		table_read_end(shared, &reader);
+		table_synchronize(shared);
+		TEST(table_reclaim(shared) == 0);
+		table_reader_unregister(shared, &reader);
+
+		table_insert(shared, &k, &k, TRANSIENT, TRANSIENT);
+		started = pthread_create(&thread, NULL, concurrent_reader, shared) == 0;
+		TEST(started);
+
+		for (k = 1; k < 100000; ++k) // grow and churn while the reader looks up key 0
+		{
+			table_insert(shared, &k, &k, TRANSIENT, TRANSIENT);
+
+			if (k % 2)
+				table_erase(shared, table_find_mut(shared, &k));
+		}
+
+		pthread_mutex_lock(&readers_lock);
+		readers_stop = 1;
+		pthread_mutex_unlock(&readers_lock);
+
+		if (started && pthread_join(thread, &misses) == 0)
+		{
+			TEST(misses != NULL && *(size_t*)misses == 0);
+			free(misses);
+		}
+
+		table_free(shared);
+	}
+
+	{
+		int_map_t _ints;
+		int_map_t* ints = &_ints;
+		int_map_const_iter_t iter;
+		table_key_t k;
+		size_t found = 0;
+		size_t count = 0;
+
+		int_map_init(ints, NULL);
+		TEST(sizeof(int_map_slot_t) == sizeof(table_key_t) + sizeof(table_value_t));
+
+		for (k = 0; k < 1000; ++k)
+			int_map_insert(ints, k, -k);
+
+		TEST(int_map_size(ints) == 1000);
+		TEST(int_map_insert(ints, 10, 0) == int_map_end(ints));
+		TEST(int_map_insert(ints, INT_MAP_EMPTY_KEY, 0) == int_map_end(ints));
+		TEST(int_map_find(ints, INT_MAP_EMPTY_KEY) == int_map_end(ints));
+
+		for (k = 0; k < 1000; k += 2)
+			int_map_erase(ints, int_map_find_mut(ints, k));
+
+		for (k = 0; k < 1000; ++k)
+		{
+			iter = int_map_find(ints, k);
+			found += k % 2 ? iter != int_map_end(ints) && *int_map_value(ints, iter) == -k
+				: iter == int_map_end(ints);
+		}
+
+		TEST(found == 1000);
+
+		for (iter = int_map_begin(ints); iter != int_map_end(ints); iter = int_map_next(ints, iter))
+			count += *int_map_key(ints, iter) % 2 == 1;
+
+		TEST(count == 500);
+
+		int_map_assign(ints, int_map_find_mut(ints, 1), 100);
+		TEST(*int_map_value(ints, int_map_find(ints, 1)) == 100);
+
+		int_map_free(ints);
+	}
+
+	{
+		table_reclaimer_t _reclaimer;
+		table_reclaimer_t* reclaimer = &_reclaimer;
+		table_config_t config = { 0 };
+		table_t _deferred;
+		table_t* deferred = &_deferred;
+		table_key_t k;
+		size_t steps = 0;
+
+		TEST(table_reclaimer_init(reclaimer, 0));
+		config.reclaimer = reclaimer;
+		table_init_config(deferred, &config);
+
+		for (k = 0; k < 1000; ++k)
+			table_insert(deferred, key_new(k), value_new(k), TRANSFER, TRANSFER);
+
+		table_clear(deferred);
+		TEST(table_size(deferred) == 0);
+		TEST(table_find(deferred, &k) == table_end(deferred));
+		TEST(table_reclaim_step(reclaimer, 0) == 1000); // nothing destroyed yet
+
+		while (table_reclaim_step(reclaimer, 100) != 0)
+			steps += 1;
+
+		TEST(steps == 9);
+
+		for (k = 0; k < 10; ++k)
+			table_insert(deferred, &k, &k, STATIC, STATIC);
+
+		table_free(deferred);
+		TEST(table_reclaim_step(reclaimer, 0) == 0); // STATIC entries are never destroyed
+		table_reclaimer_free(reclaimer);
+
+		TEST(table_reclaimer_init(reclaimer, 1));
+		table_init_config(deferred, &config);
+
+		for (k = 0; k < 1000; ++k) // owned entries, so the background thread runs the destructors
+			table_insert(deferred, key_new(k), value_new(k), TRANSFER, TRANSFER);
+
+		table_free(deferred);
+		table_reclaimer_free(reclaimer); // waits for the background thread
+	}
+
+	{
+		table_key_t k;
+		table_iter_t iter;
+		size_t peak;
+		int inserted;
+
+		table_clear(table);
+		TEST(table_shrink_to_fit(table)); // clears the reserve floor left by table_reserve above
+		TEST(table_capacity(table) >= TABLE_MIN_CAPACITY);
+
+		for (k = 0; k < 10000; ++k)
+			table_insert(table, &k, &k, TRANSIENT, TRANSIENT);
+
+		peak = table_capacity(table);
+		TEST(peak >= 10000);
+
+		for (iter = table_begin_mut(table); iter != table_end(table); )
+		{
+			if (*table_key(table, iter) >= 10)
+				iter = table_erase(table, iter);
+			else
+				iter = table_next_mut(table, iter);
+		}
+
+		TEST(table_size(table) == 10);
+		TEST(table_capacity(table) == peak); // table_erase never shrinks
+
+		k = 0;
+		iter = table_find_or_insert(table, &k, TRANSIENT, &inserted); // a hit neither shrinks nor rehashes
+		TEST(!inserted);
+		TEST(table_capacity(table) == peak);
+		TEST(iter == table_find_mut(table, &k));
+
+		k = 10;
+		table_insert(table, &k, &k, TRANSIENT, TRANSIENT); // shrinks on the next insertion
+		TEST(table_capacity(table) < peak / 8);
+		TEST(table_find(table, &k) != table_end(table));
+
+		k = 11;
+		table_insert(table, &k, &k, TRANSIENT, TRANSIENT);
+		k = 5;
+		table_erase(table, table_find_mut(table, &k));
+		TEST(table_shrink_to_fit(table));
+		TEST(table_capacity(table) >= table_size(table));
+		TEST(table_capacity(table) <= 32);
+		TEST(table_size(table) == 11);
+
+		TEST(table_reserve(table, 1000));
+		peak = table_capacity(table);
+		k = 12;
+		table_insert(table, &k, &k, TRANSIENT, TRANSIENT); // the reserve floor keeps the room reserved
+		TEST(table_capacity(table) == peak);
+		TEST(table_shrink_to_fit(table));
+		TEST(table_capacity(table) <= 32);
+
+		table_clear(table);
+	}
+
+	{
+		table_config_t config = { 0 };
+		table_t _huge;
+		table_t* huge = &_huge;
+		table_key_t k;
+		size_t found = 0;
+
+		config.pages = TABLE_PAGES_HUGE; // falls back to malloc where unsupported
+		config.numa = TABLE_NUMA_FIRST_TOUCH;
+		config.numa_threads = 4;
+		table_init_config(huge, &config);
+		TEST(table_reserve(huge, 1 << 20));
+
+		for (k = 0; k < 1 << 20; ++k)
+			table_insert(huge, &k, &k, TRANSIENT, TRANSIENT);
+
+		for (k = 0; k < 1 << 20; k += 97)
+			found += table_find(huge, &k) != table_end(huge);
+
+		TEST(found == ((1 << 20) + 96) / 97);
+
+		#ifdef TABLE_STATS
+		{
+			table_stats_t stats;
+			size_t huge_page = (size_t)2 << 20;
+
+			table_stats(huge, &stats); // mapped arrays are whole 2MB pages, a fallback maps nothing
+			TEST(stats.huge_page_bytes % huge_page == 0);
+			TEST(stats.huge_page_bytes == 0 || stats.huge_page_bytes >= (size_t)(1 << 20) * sizeof(table_node_t));
+		}
+		#endif
+
+		table_free(huge);
+
+		config.numa = TABLE_NUMA_INTERLEAVE;
+		table_init_config(huge, &config);
+		k = 1;
+		TEST(table_insert(huge, &k, &k, TRANSIENT, TRANSIENT) != table_end(huge));
+
+		#ifdef TABLE_STATS
+		{
+			table_stats_t stats;
+
+			table_stats(huge, &stats); // arrays below 2MB always come from malloc
+			TEST(stats.huge_page_bytes == 0);
+		}
+		#endif
+
+		table_free(huge);
+
+		config.pages = TABLE_PAGES_DEFAULT;
+		table_init_config(huge, &config);
+		TEST(table_reserve(huge, 1 << 20));
+
+		#ifdef TABLE_STATS
+		{
+			table_stats_t stats;
+
+			table_stats(huge, &stats);
+			TEST(stats.huge_page_bytes == 0);
+		}
+		#endif
+
+		table_free(huge);
+	}
+
+	{
+		table_range_t ranges[8];
+		table_const_iter_t iter;
+		table_key_t k;
+		size_t range_count;
+		size_t count = 0;
+		long long sum = 0;
+		size_t i;
+
+		table_clear(table);
+
+		for (k = 0; k < 5000; ++k)
+			table_insert(table, &k, &k, TRANSIENT, TRANSIENT);
+
+		range_count = table_partition(table, 8, ranges);
+		TEST(range_count == 8);
+
+		for (i = 0; i < range_count; ++i)
+		{
+			TEST(i == 0 || ranges[i].first == ranges[i - 1].last);
+
+			for (iter = table_range_begin(table, &ranges[i]); iter != table_end(table);
+				iter = table_range_next(table, &ranges[i], iter))
+				count += 1;
+		}
+
+		TEST(count == 5000);
+
+		table_parallel_foreach(table, sum_entries, &sum, 4);
+		TEST(sum == 4999LL * 5000 / 2);
+
+		table_clear(table);
+	}
+
+	{
+		table_config_t config = { 0 };
+		table_t _filtered;
+		table_t* filtered = &_filtered;
+		table_key_t k;
+		size_t found;
+		int filter;
+
+		for (filter = TABLE_FILTER_BLOCKED_BLOOM; filter <= TABLE_FILTER_QUOTIENT; ++filter)
+		{
+			config.filter = (table_filter_t)filter;
+			config.filter_bits_per_key = 12;
+			table_init_config(filtered, &config);
+
+			for (k = 0; k < 2000; k += 2)
+				table_insert(filtered, &k, &k, TRANSIENT, TRANSIENT);
+
+			for (k = 0, found = 0; k < 2000; ++k)
+				found += table_find(filtered, &k) != table_end(filtered);
+
+			TEST(found == 1000); // no false negatives, false positives still probe the table
+
+			k = 10;
+			table_erase(filtered, table_find_mut(filtered, &k));
+			TEST(table_find(filtered, &k) == table_end(filtered));
+			TEST(table_insert(filtered, &k, &k, TRANSIENT, TRANSIENT) != table_end(filtered));
+			TEST(table_find(filtered, &k) != table_end(filtered));
+
+			table_free(filtered);
+		}
+	}
+
+	{
+		table_config_t config = { 0 };
+		table_t _ordered;
+		table_t* ordered = &_ordered;
+		table_const_iter_t iter;
+		table_key_t k;
+		table_key_t lo = 100;
+		table_key_t hi = 200;
+		table_key_t previous = -1;
+		long long sum = 0;
+		size_t sorted = 0;
+
+		config.index = TABLE_INDEX_BTREE;
+		table_init_config(ordered, &config);
+
+		for (k = 0; k < 10000; ++k) // insert 0, 3, 6, ... in scrambled order
+		{
+			table_key_t key = (k * 7919 % 10000) * 3;
+			table_insert(ordered, &key, &key, TRANSIENT, TRANSIENT);
+		}
+
+		k = 100;
+		TEST(*table_key(ordered, table_lower_bound(ordered, &k)) == 102);
+		k = 30000;
+		TEST(table_lower_bound(ordered, &k) == table_end(ordered));
+
+		TEST(table_range(ordered, &lo, &hi, sum_entries, &sum) == 33); // 102 ... 198
+		TEST(sum == (102 + 198) * 33 / 2);
+
+		k = 102;
+		table_erase(ordered, table_find_mut(ordered, &k));
+		k = 100;
+		TEST(*table_key(ordered, table_lower_bound(ordered, &k)) == 105);
+
+		for (iter = table_ordered_begin(ordered); iter != table_end(ordered); iter = table_ordered_next(ordered, iter))
+		{
+			sorted += *table_key(ordered, iter) > previous;
+			previous = *table_key(ordered, iter);
+		}
+
+		TEST(sorted == 9999);
+		table_free(ordered);
+	}
+
+	{
+		cache_t _cache;
+		cache_t* cache = &_cache;
+		sharded_cache_t _shared;
+		sharded_cache_t* shared = &_shared;
+		table_key_t k;
+		table_value_t v;
+		size_t hits = 0;
+		size_t adopted = 0;
+		int inserted;
+
+		cache_init(cache, 3, CACHE_LRU, NULL);
+
+		for (k = 1; k <= 3; ++k)
+		{
+			cache_put(cache, key_new(k), value_new(k * 10), TRANSFER, TRANSFER, &inserted);
+			adopted += inserted;
+		}
+
+		TEST(adopted == 3);
+
+		k = 1;
+		TEST(*cache_value(cache, cache_get(cache, &k)) == 10); // 1 becomes most recently used
+		k = 4;
+		cache_put(cache, &k, &k, TRANSIENT, TRANSIENT, NULL); // evicts 2, releasing its TRANSFER key and value
+
+		TEST(cache_size(cache) == 3);
+		k = 2;
+		TEST(cache_peek(cache, &k) == NULL);
+		k = 1;
+		TEST(cache_peek(cache, &k) != NULL);
+
+		v = 11;
+		TEST(*cache_value(cache, cache_put(cache, &k, &v, TRANSIENT, TRANSIENT, &inserted)) == 11);
+		TEST(!inserted);
+		TEST(cache_size(cache) == 3);
+
+		{
+			table_key_t* duplicate = key_new(3);
+
+			cache_put(cache, duplicate, value_new(31), TRANSFER, TRANSFER, &inserted);
+			TEST(!inserted);
+			free(duplicate); // not taken, the existing key of 3 is kept
+		}
+
+		cache_erase(cache, cache_get(cache, &k));
+		TEST(cache_get(cache, &k) == NULL);
+		TEST(cache_size(cache) == 2);
+		cache_free(cache);
+
+		cache_init(cache, 3, CACHE_CLOCK, NULL);
+
+		for (k = 1; k <= 3; ++k)
+			cache_put(cache, &k, &k, TRANSIENT, TRANSIENT, NULL);
+
+		k = 1;
+		cache_get(cache, &k); // second chance for 1
+		k = 4;
+		cache_put(cache, &k, &k, TRANSIENT, TRANSIENT, NULL);
+
+		k = 1;
+		TEST(cache_peek(cache, &k) != NULL);
+		k = 2;
+		TEST(cache_peek(cache, &k) == NULL);
+		cache_free(cache);
+
+		TEST(sharded_cache_init(shared, 8, 1000, CACHE_CLOCK, NULL));
+
+		for (k = 0; k < 2000; ++k)
+			sharded_cache_put(shared, &k, &k, TRANSIENT, TRANSIENT, NULL);
+
+		TEST(sharded_cache_size(shared) <= 1000);
+
+		for (k = 0; k < 2000; ++k)
+			hits += sharded_cache_get(shared, &k, &v) && v == k;
+
+		TEST(hits == sharded_cache_size(shared));
+		k = 1999; // the newest key of its shard survives every sweep
+		TEST(sharded_cache_erase(shared, &k) == 1);
+		TEST(sharded_cache_get(shared, &k, &v) == 0);
+		sharded_cache_free(shared);
+	}
+
+	{
+		aggregate_t _groups;
+		aggregate_t* groups = &_groups;
+		aggregate_row_t rows[1000];
+		const aggregate_state_t* state;
+		table_key_t k;
+		size_t matching = 0;
+		size_t visited = 0;
+		size_t i;
+		int partitioned;
+		int initialized;
+
+		for (i = 0; i < 1000; ++i)
+		{
+			rows[i].key = (table_key_t)(i % 100);
+			rows[i].value = (double)i;
+		}
+
+		for (partitioned = 0; partitioned <= 1; ++partitioned) // a 1KB budget forces radix partitioning
+		{
+			initialized = aggregate_init(groups, 100, partitioned ? 1024 : 0, NULL);
+			TEST(initialized);
+
+			if (!initialized)
+				continue;
+
+			TEST(aggregate_add(groups, rows, 1000));
+			TEST(aggregate_add(groups, rows, 500)); // rows 0 ... 499 twice
+			TEST(aggregate_finish(groups));
+			TEST(aggregate_groups(groups) == 100);
+
+			k = 7; // values 7, 107, ..., 907, then 7, 107, ..., 407 again
+			state = aggregate_find(groups, &k);
+			TEST(state != NULL && state->key == 7 && state->count == 15);
+			TEST(state != NULL && state->sum == 4570 + 1035 && state->min == 7 && state->max == 907);
+
+			k = 100;
+			TEST(aggregate_find(groups, &k) == NULL);
+
+			for (state = aggregate_begin(groups); state; state = aggregate_next(groups, state), ++visited)
+				matching += state->count == 15 && state->min == state->key && state->max == state->key + 900;
+
+			aggregate_clear(groups);
+			TEST(aggregate_finish(groups) && aggregate_groups(groups) == 0);
+			aggregate_free(groups);
+		}
+
+		TEST(visited == 200);
+		TEST(matching == 200);
+	}
+
+	{
+		join_t _join;
+		join_t* join = &_join;
+		join_cursor_t cursor;
+		join_row_t build[1010];
+		join_row_t probe[2000];
+		join_match_t out[64];
+		join_match_t buffers[4 * 16];
+		size_t i;
+		int mode;
+
+		for (i = 0; i < 1000; ++i) // build payloads mirror their keys, 1000 + k duplicates keys 0 ... 9
+		{
+			build[i].key = (table_key_t)i;
+			build[i].payload = i;
+		}
+
+		for (i = 0; i < 10; ++i)
+		{
+			build[1000 + i].key = (table_key_t)i;
+			build[1000 + i].payload = 1000 + i;
+		}
+
+		for (i = 0; i < 2000; ++i) // probe payloads are 5000 + k, keys 1000 ... 1999 have no match
+		{
+			probe[i].key = (table_key_t)(1999 - i);
+			probe[i].payload = 5000 + 1999 - i;
+		}
+
+		for (mode = JOIN_DEFAULT; mode <= JOIN_RADIX; ++mode)
+		{
+			size_t emitted = 0;
+			size_t consistent = 0;
+			size_t written;
+			long long checked = 0;
+
+			join_init(join, (join_mode_t)mode, NULL);
+			TEST(join_build(join, build, 1010));
+			TEST(join_build_size(join) == 1010);
+			TEST(join_cursor_init(join, &cursor, probe, 2000));
+
+			while ((written = join_probe(join, &cursor, out, 64)) != 0) // resumes across buffer refills
+			{
+				for (i = 0; i < written; ++i)
+					consistent += out[i].build % 1000 == out[i].probe - 5000;
+
+				emitted += written;
+			}
+
+			TEST(emitted == 1010);
+			TEST(consistent == 1010);
+			TEST(join_probe(join, &cursor, out, 64) == 0);
+
+			TEST(join_probe_parallel(join, probe, 2000, 4, NULL, 16, check_matches, &checked) == 1010);
+			TEST(checked == 1010);
+			TEST(join_probe_parallel(join, probe, 2000, 4, buffers, 16, check_matches, &checked) == 1010);
+			TEST(checked == 2020);
+			TEST(join_probe_parallel(join, probe, 2000, 0, buffers, 16, check_matches, &checked) == (size_t)-1);
+			TEST(checked == 2020);
+
+			TEST(join_build(join, build, 0));
+			TEST(join_cursor_init(join, &cursor, probe, 2000));
+			TEST(join_probe(join, &cursor, out, 64) == 0);
+			join_free(join);
+		}
+	}
+
+	#ifdef TABLE_STATS
+	{
+		table_stats_t stats;
+		table_key_t k;
+		size_t probes = 0;
+		int i;
+
+		table_clear(table);
+
+		for (k = 0; k < 10; ++k)
+			table_insert(table, &k, &k, TRANSIENT, TRANSIENT);
+
+		table_stats_reset(table);
+
+		for (k = 0; k < 20; ++k)
+			table_find(table, &k);
+
+		table_stats(table, &stats);
+		TEST(stats.size == 10);
+		TEST(stats.capacity >= 10);
+		TEST(stats.load_factor == (double)stats.size / stats.capacity);
+		TEST(stats.lookups == 20);
+		TEST(stats.key_compares >= 10); // every hit compares at least once
+
+		for (i = 0; i < TABLE_STATS_PROBE_LENGTHS; ++i)
+			probes += stats.probe_lengths[i];
+
+		TEST(probes == 20);
+
+		if (TABLE_INLINE_KEY && TABLE_INLINE_VALUE) // TRANSIENT copies live inside the nodes
+		{
+			TEST(stats.transient_bytes == 0);
+		}
+
+		table_clear(table);
+	}
+	#endif
+
 	printf("All tests completed, summary: %lu/%lu tests passed.\n", success, total);
 	return 0;
 }
@@ -98,3 +1094,65 @@ static table_value_t* value_new(table_value_t value)
 
 	return v;
 }
+
+static void sum_entries(const table_t* shard, table_const_iter_t iter, void* context)
+{
+	static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER; // invoked from the thread pool
+
+	pthread_mutex_lock(&lock);
+	*(long long*)context += *table_value(shard, iter);
+	pthread_mutex_unlock(&lock);
+}
+
+static void* concurrent_reader(void* context)
+{
+	const table_t* table = (const table_t*)context;
+	size_t* misses = (size_t*)malloc(sizeof(size_t));
+	table_reader_t reader;
+	table_const_iter_t iter;
+	table_key_t k = 0;
+
+	if (!misses || !table_reader_register(table, &reader))
+	{
+		free(misses);
+		return NULL;
+	}
+
+	*misses = 0;
+
+	while (!readers_stopped())
+	{
+		table_read_begin(table, &reader);
+		iter = table_find(table, &k);
+		*misses += iter == table_end(table) || *table_value(table, iter) != 0;
+		table_read_end(table, &reader);
+	}
+
+	table_reader_unregister(table, &reader);
+	return misses;
+}
+
+static int readers_stopped(void)
+{
+	int stop;
+
+	pthread_mutex_lock(&readers_lock);
+	stop = readers_stop;
+	pthread_mutex_unlock(&readers_lock);
+
+	return stop;
+}
+
+static void check_matches(const join_match_t* matches, size_t count, size_t thread, void* context)
+{
+	static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER; // invoked from the probe threads
+	size_t i;
+
+	(void)thread;
+	pthread_mutex_lock(&lock);
+
+	for (i = 0; i < count; ++i)
+		*(long long*)context += matches[i].build % 1000 == matches[i].probe - 5000;
+
+	pthread_mutex_unlock(&lock);
+}
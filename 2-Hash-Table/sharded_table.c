@@ -0,0 +1,46 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include "sharded_table.h"
+
+/* Sharded table interface implementation */
+
+int sharded_table_init(sharded_table_t* table, size_t shard_count, size_t thread_count,
+	const table_config_t* config);
+
+void sharded_table_free(sharded_table_t* table);
+
+void sharded_table_clear(sharded_table_t* table);
+
+size_t sharded_table_size(const sharded_table_t* table);
+
+size_t sharded_table_shard_count(const sharded_table_t* table);
+
+size_t sharded_table_route(const sharded_table_t* table, const table_key_t* key);
+
+table_t* sharded_table_shard(sharded_table_t* table, size_t shard);
+
+void sharded_table_lock(sharded_table_t* table, size_t shard);
+void sharded_table_unlock(sharded_table_t* table, size_t shard);
+
+sharded_table_iter_t sharded_table_insert(sharded_table_t* table, table_key_t* key, table_value_t* value,
+	storage_mode key_storage_mode, storage_mode value_storage_mode);
+
+sharded_table_iter_t sharded_table_erase(sharded_table_t* table, sharded_table_iter_t iter);
+
+sharded_table_const_iter_t sharded_table_find(const sharded_table_t* table, const table_key_t* key);
+sharded_table_iter_t sharded_table_find_mut(sharded_table_t* table, const table_key_t* key);
+
+size_t sharded_table_insert_bulk(sharded_table_t* table, table_key_t* const* keys, table_value_t* const* values,
+	size_t n, storage_mode key_storage_mode, storage_mode value_storage_mode, size_t* duplicates);
+
+void sharded_table_foreach(const sharded_table_t* table, table_callback_t callback, void* context);
+
+sharded_table_iter_t sharded_table_begin(sharded_table_t* table);
+
+sharded_table_iter_t sharded_table_end(sharded_table_t* table);
+sharded_table_const_iter_t sharded_table_cend(const sharded_table_t* table);
+
+sharded_table_iter_t sharded_table_next(sharded_table_t* table, sharded_table_iter_t iter);
+
+int sharded_table_iter_equal(sharded_table_iter_t iter1, sharded_table_iter_t iter2);
+int sharded_table_const_iter_equal(sharded_table_const_iter_t iter1, sharded_table_const_iter_t iter2);
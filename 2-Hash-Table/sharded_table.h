@@ -0,0 +1,227 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "table.h"
+
+/**
+ * The sharded_table_t type partitions entries over independent table_t shards for multi-core use.
+ *
+ * Implementation-defined specification:
+ *   sharded_table_t: Sharded table structure type definition.
+ *
+ * Expectations:
+ *   A key is routed by the high log2(shard_count) bits of its hash (the configured hasher), while each shard indexes
+ *    its buckets with the low bits, so routing does not skew the distribution inside a shard.
+ *   Every shard owns its table_t, its lock, and its own allocator, and is aligned and padded to
+ *    SHARDED_TABLE_CACHE_LINE bytes so no two shards share a cache line. A shard's bucket arrays and out-of-line nodes
+ *    are carved from a per-shard arena of large blocks rather than from a process-wide malloc, so threads working on
+ *    different shards never contend on allocator locks or share allocator metadata. Memory freed by a shard returns
+ *    to its own arena, and clearing or freeing a shard releases its blocks at once.
+ *   sharded_table_insert, sharded_table_erase, sharded_table_find, and sharded_table_find_mut may be called
+ *    concurrently from any number of threads and only lock the shard of the key. An iterator they return stays valid
+ *    until its shard is next modified, callers that keep iterators while other threads write must hold the shard
+ *    with sharded_table_lock.
+ *   Bulk operations (sharded_table_clear, sharded_table_free, sharded_table_foreach, sharded_table_insert_bulk) run
+ *    one task per shard on the table's thread pool and return once all tasks have finished. They must not run
+ *    concurrently with any other operation on the same table.
+ *   Sequential iteration (sharded_table_begin, sharded_table_next) walks the shards in order.
+ *   Threads are POSIX threads.
+ *
+ * All functions aside from sharded_table_init expect an initialized table, providing an uninitialized table shall be
+ *  undefined behavior.
+ * The function sharded_table_init expects an uninitialized table, providing an initialized table shall be undefined
+ *  behavior.
+ */
+
+#define SHARDED_TABLE_CACHE_LINE 64
+
+typedef struct sharded_table_t
+{
+	/* implementation defined */
+} sharded_table_t;
+
+typedef struct sharded_table_iter_t
+{
+	size_t shard;
+	table_iter_t iter; /* table_end of the last shard at the end */
+} sharded_table_iter_t;
+
+typedef struct sharded_table_const_iter_t
+{
+	size_t shard;
+	table_const_iter_t iter; /* table_end of the last shard at the end */
+} sharded_table_const_iter_t;
+
+/**
+ * Initializes the given sharded table.
+ * @param table A pointer to an uninitialized sharded table.
+ * @param shard_count The number of shards, a power of two.
+ * @param thread_count The number of thread pool workers, 0 for the number of online processors.
+ * @param config A pointer to the configuration of every shard, NULL for the default.
+ * @return 1 on success, 0 on failure leaving the table uninitialized.
+ */
+int sharded_table_init(sharded_table_t* table, size_t shard_count, size_t thread_count,
+	const table_config_t* config);
+
+/**
+ * Releases resources used by the given sharded table, freeing the shards in parallel and stopping the thread pool.
+ * The table will become in an uninitialized state after this call.
+ * @param table A pointer to an initialized sharded table.
+ */
+void sharded_table_free(sharded_table_t* table);
+
+/**
+ * Clears all entries of the given sharded table, clearing the shards in parallel.
+ * @param table A pointer to an initialized sharded table.
+ */
+void sharded_table_clear(sharded_table_t* table);
+
+/**
+ * Returns the number of entries in the given sharded table.
+ * @param table A pointer to an initialized sharded table.
+ * @return The sum of the sizes of the shards.
+ */
+size_t sharded_table_size(const sharded_table_t* table);
+
+/**
+ * Returns the number of shards of the given sharded table.
+ * @param table A pointer to an initialized sharded table.
+ * @return The shard count passed to sharded_table_init.
+ */
+size_t sharded_table_shard_count(const sharded_table_t* table);
+
+/**
+ * Returns the shard a key is routed to.
+ * @param table A pointer to an initialized sharded table.
+ * @param key A pointer to the key.
+ * @return The index of the shard, in the range [0, shard_count).
+ */
+size_t sharded_table_route(const sharded_table_t* table, const table_key_t* key);
+
+/**
+ * Returns a shard of the sharded table.
+ * @param table A pointer to an initialized sharded table.
+ * @param shard The index of the shard, in the range [0, shard_count).
+ * @return A pointer to the table of the shard.
+ */
+table_t* sharded_table_shard(sharded_table_t* table, size_t shard);
+
+/**
+ * Acquires the lock of a shard, blocking the concurrent operations routed to it.
+ * @param table A pointer to an initialized sharded table.
+ * @param shard The index of the shard, in the range [0, shard_count).
+ */
+void sharded_table_lock(sharded_table_t* table, size_t shard);
+
+/**
+ * Releases the lock of a shard acquired by sharded_table_lock.
+ * @param table A pointer to an initialized sharded table.
+ * @param shard The index of the shard, in the range [0, shard_count).
+ */
+void sharded_table_unlock(sharded_table_t* table, size_t shard);
+
+/**
+ * Inserts a key-value pair into the shard of the key, see table_insert.
+ * @param table A pointer to an initialized sharded table.
+ * @param key A pointer to the key.
+ * @param value A pointer to the value.
+ * @param key_storage_mode The storage mode of the key.
+ * @param value_storage_mode The storage mode of the value.
+ * @return The iterator of the newly inserted entry, sharded_table_end(table) on failure.
+ */
+sharded_table_iter_t sharded_table_insert(sharded_table_t* table, table_key_t* key, table_value_t* value,
+	storage_mode key_storage_mode, storage_mode value_storage_mode);
+
+/**
+ * Erases a key-value pair from the sharded table.
+ * @param table A pointer to an initialized sharded table.
+ * @param iter A valid iterator excluding sharded_table_end(table) to the entry to remove.
+ * @return The iterator of the next entry, sharded_table_end(table) if at end.
+ */
+sharded_table_iter_t sharded_table_erase(sharded_table_t* table, sharded_table_iter_t iter);
+
+/**
+ * Returns the iterator associated to an entry.
+ * @param table A pointer to an initialized sharded table.
+ * @param key A pointer to the key.
+ * @return The iterator of the entry if found, sharded_table_cend(table) on failure.
+ */
+sharded_table_const_iter_t sharded_table_find(const sharded_table_t* table, const table_key_t* key);
+
+/**
+ * Returns the mutable iterator associated to an entry.
+ * @param table A pointer to an initialized sharded table.
+ * @param key A pointer to the key.
+ * @return The iterator of the entry if found, sharded_table_end(table) on failure.
+ */
+sharded_table_iter_t sharded_table_find_mut(sharded_table_t* table, const table_key_t* key);
+
+/**
+ * Inserts a large number of key-value pairs, see table_insert_bulk.
+ * The pairs are partitioned by shard and every shard is then bulk inserted in parallel.
+ * @param table A pointer to an initialized sharded table.
+ * @param keys An array of n pointers to keys.
+ * @param values An array of n pointers to values.
+ * @param n The number of key-value pairs.
+ * @param key_storage_mode The storage mode of every key.
+ * @param value_storage_mode The storage mode of every value.
+ * @param duplicates An array of at least n indices receiving, in increasing order, the index of every pair that was
+ *  not inserted, may be NULL.
+ * @return The number of pairs that were not inserted.
+ */
+size_t sharded_table_insert_bulk(sharded_table_t* table, table_key_t* const* keys, table_value_t* const* values,
+	size_t n, storage_mode key_storage_mode, storage_mode value_storage_mode, size_t* duplicates);
+
+/**
+ * Invokes a callback for every entry, the shards are visited in parallel and the entries of one shard sequentially.
+ * @param table A pointer to an initialized sharded table.
+ * @param callback The function to invoke with the table of the entry's shard, it may run on any thread of the pool.
+ * @param context Passed to every invocation of the callback.
+ */
+void sharded_table_foreach(const sharded_table_t* table, table_callback_t callback, void* context);
+
+/**
+ * Returns the iterator associated to the first entry of the first non-empty shard.
+ * @param table A pointer to an initialized sharded table.
+ * @return The iterator of the first entry, sharded_table_end(table) on empty table.
+ */
+sharded_table_iter_t sharded_table_begin(sharded_table_t* table);
+
+/**
+ * Returns the iterator associated to the end of a sharded table.
+ * @param table A pointer to an initialized sharded table.
+ * @return The iterator { shard_count - 1, table_end(last shard) }.
+ */
+sharded_table_iter_t sharded_table_end(sharded_table_t* table);
+
+/**
+ * Returns the constant iterator associated to the end of a sharded table.
+ * @param table A pointer to an initialized sharded table.
+ * @return The iterator { shard_count - 1, table_end(last shard) }.
+ */
+sharded_table_const_iter_t sharded_table_cend(const sharded_table_t* table);
+
+/**
+ * Returns the iterator proceeding a given iterator, moving on to the next non-empty shard at the end of a shard.
+ * @param table A pointer to an initialized sharded table.
+ * @param iter A valid iterator excluding sharded_table_end(table) to the entry.
+ * @return The iterator proceeding the given iterator, sharded_table_end(table) on end reached.
+ */
+sharded_table_iter_t sharded_table_next(sharded_table_t* table, sharded_table_iter_t iter);
+
+/**
+ * Returns whether two iterators refer to the same entry.
+ * @param iter1 An iterator.
+ * @param iter2 An iterator.
+ * @return 1 if identical, 0 otherwise.
+ */
+int sharded_table_iter_equal(sharded_table_iter_t iter1, sharded_table_iter_t iter2);
+
+/**
+ * Returns whether two constant iterators refer to the same entry.
+ * @param iter1 An iterator.
+ * @param iter2 An iterator.
+ * @return 1 if identical, 0 otherwise.
+ */
+int sharded_table_const_iter_equal(sharded_table_const_iter_t iter1, sharded_table_const_iter_t iter2);
@@ -0,0 +1,34 @@
+#include <stdlib.h>
+#include <string.h>
+#include "string_table.h"
+
+/* String table interface implementation */
+
+void string_table_init(string_table_t* table, uint64_t seed);
+
+void string_table_free(string_table_t* table);
+
+void string_table_clear(string_table_t* table);
+
+size_t string_table_size(const string_table_t* table);
+
+string_table_iter_t string_table_insert(string_table_t* table, const char* key, size_t length, table_value_t* value,
+	storage_mode value_storage_mode);
+
+string_table_iter_t string_table_erase(string_table_t* table, string_table_iter_t iter);
+
+const char* string_table_key(const string_table_t* table, string_table_const_iter_t iter, size_t* length);
+
+const table_value_t* string_table_value(const string_table_t* table, string_table_const_iter_t iter);
+
+string_table_iter_t string_table_assign(string_table_t* table, string_table_iter_t iter, table_value_t* value,
+	storage_mode value_storage_mode);
+
+string_table_const_iter_t string_table_find(const string_table_t* table, const char* key, size_t length);
+string_table_iter_t string_table_find_mut(string_table_t* table, const char* key, size_t length);
+
+string_table_const_iter_t string_table_begin(const string_table_t* table);
+
+string_table_const_iter_t string_table_end(const string_table_t* table);
+
+string_table_const_iter_t string_table_next(const string_table_t* table, string_table_const_iter_t iter);
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "table.h"
+
+/**
+ * The string_table_t type implements a hash table specialized for variable-length string keys.
+ *
+ * Implementation-defined specification:
+ *   string_table_slot_t: Entry structure type definition.
+ *   string_table_t: String table structure type definition.
+ *
+ * Expectations:
+ *   Keys are byte strings identified by a pointer and a length (they may contain null bytes), every function taking a
+ *    key accepts it as (const char*, size_t) so no key object has to be built for a lookup. Slots store lengths in 32
+ *    bits, so keys longer than STRING_TABLE_MAX_KEY bytes are rejected by string_table_insert (which fails without
+ *    reading them) and never found by lookups.
+ *   Keys are always copied and managed by the table. A key shorter than STRING_TABLE_INLINE_KEY bytes is stored
+ *    inline in its slot, longer keys are copied into an arena shared by the whole table. Stored keys are followed by a
+ *    null byte. Arena space of erased keys is reclaimed when the table rehashes.
+ *   Values are table_value_t and follow the storage modes of table.h, using value_duplicator and value_destructor.
+ *   Every slot caches the full 64-bit hash of its key (computed with table_hash_bytes and the table's seed). A probe
+ *    compares cached hashes first and only compares key bytes when the hashes are equal, so lookups of absent keys
+ *    almost never touch key bytes.
+ *   String table slots are not to be accessed or manipulated outside the interface.
+ *
+ * All functions aside from string_table_init expect an initialized table, providing an uninitialized table shall be
+ *  undefined behavior.
+ * The function string_table_init expects an uninitialized table, providing an initialized table shall be undefined
+ *  behavior.
+ * Passing iterators to functions that are invalidated (from removing, rehashing, etc.) shall be undefined behavior.
+ */
+
+#define STRING_TABLE_INLINE_KEY 16
+#define STRING_TABLE_MAX_KEY UINT32_MAX
+
+typedef struct string_table_slot_t
+{
+	uint64_t hash;
+	uint32_t length;
+
+	union
+	{
+		const char* ptr; /* length >= STRING_TABLE_INLINE_KEY, points into the arena */
+		char local[STRING_TABLE_INLINE_KEY]; /* length < STRING_TABLE_INLINE_KEY */
+	} key;
+
+	union
+	{
+		table_value_t* ptr; /* STATIC, TRANSFER, or TRANSIENT when !TABLE_INLINE_VALUE */
+		table_value_t local; /* TRANSIENT when TABLE_INLINE_VALUE */
+	} value;
+
+	storage_mode value_storage_type;
+} string_table_slot_t;
+
+typedef string_table_slot_t* string_table_iter_t;
+typedef const string_table_slot_t* string_table_const_iter_t;
+
+typedef struct string_table_t
+{
+	/* implementation defined, use string_table_slot_t for entries */
+} string_table_t;
+
+/**
+ * Initializes the given string table.
+ * @param table A pointer to an uninitialized string table.
+ * @param seed The seed passed to table_hash_bytes.
+ */
+void string_table_init(string_table_t* table, uint64_t seed);
+
+/**
+ * Releases resources used by the given string table, including its key arena.
+ * The table will become in an uninitialized state after this call.
+ * @param table A pointer to an initialized string table.
+ */
+void string_table_free(string_table_t* table);
+
+/**
+ * Clears all entries of the given string table.
+ * @param table A pointer to an initialized string table.
+ */
+void string_table_clear(string_table_t* table);
+
+/**
+ * Returns the number of entries in the given string table.
+ * @param table A pointer to an initialized string table.
+ * @return The number of entries (key-value pairs) residing in the table.
+ */
+size_t string_table_size(const string_table_t* table);
+
+/**
+ * Inserts a key-value pair into the string table, copying the key.
+ * If the key already exists in the table or is longer than STRING_TABLE_MAX_KEY bytes, the insertion is a failure.
+ * @param table A pointer to an initialized string table.
+ * @param key A pointer to the first byte of the key.
+ * @param length The length of the key in bytes.
+ * @param value A pointer to the value.
+ * @param value_storage_mode The storage mode of the value.
+ * @return The iterator of the newly inserted entry, string_table_end(table) on failure.
+ */
+string_table_iter_t string_table_insert(string_table_t* table, const char* key, size_t length, table_value_t* value,
+	storage_mode value_storage_mode);
+
+/**
+ * Erases a key-value pair from the string table.
+ * @param table A pointer to an initialized string table.
+ * @param iter A valid iterator excluding string_table_end(table) to the entry to remove.
+ * @return The iterator of the next entry, string_table_end(table) if at end.
+ */
+string_table_iter_t string_table_erase(string_table_t* table, string_table_iter_t iter);
+
+/**
+ * Returns the key associated with an iterator.
+ * @param table A pointer to an initialized string table.
+ * @param iter A valid iterator excluding string_table_end(table) to the entry to access.
+ * @param length A pointer receiving the length of the key, may be NULL.
+ * @return A pointer to the null-terminated key associated with the iterator.
+ */
+const char* string_table_key(const string_table_t* table, string_table_const_iter_t iter, size_t* length);
+
+/**
+ * Returns the value associated with an iterator.
+ * @param table A pointer to an initialized string table.
+ * @param iter A valid iterator excluding string_table_end(table) to the entry to access.
+ * @return A pointer to the value associated with the iterator.
+ */
+const table_value_t* string_table_value(const string_table_t* table, string_table_const_iter_t iter);
+
+/**
+ * Assigns a new value to the iterator.
+ * @param table A pointer to an initialized string table.
+ * @param iter A valid iterator excluding string_table_end(table) to the entry to mutate.
+ * @param value A pointer to the new value.
+ * @param value_storage_mode The storage mode of the new value.
+ * @return The iterator passed to the function.
+ */
+string_table_iter_t string_table_assign(string_table_t* table, string_table_iter_t iter, table_value_t* value,
+	storage_mode value_storage_mode);
+
+/**
+ * Returns the iterator associated to an entry.
+ * @param table A pointer to an initialized string table.
+ * @param key A pointer to the first byte of the key.
+ * @param length The length of the key in bytes.
+ * @return The iterator of the entry if found, string_table_end(table) on failure.
+ */
+string_table_const_iter_t string_table_find(const string_table_t* table, const char* key, size_t length);
+
+/**
+ * Returns the mutable iterator associated to an entry.
+ * @param table A pointer to an initialized string table.
+ * @param key A pointer to the first byte of the key.
+ * @param length The length of the key in bytes.
+ * @return The iterator of the entry if found, string_table_end(table) on failure.
+ */
+string_table_iter_t string_table_find_mut(string_table_t* table, const char* key, size_t length);
+
+/**
+ * Returns the iterator associated to the first entry in a string table.
+ * @param table A pointer to an initialized string table.
+ * @return The iterator of the first entry, string_table_end(table) on empty table.
+ */
+string_table_const_iter_t string_table_begin(const string_table_t* table);
+
+/**
+ * Returns the iterator associated to the end of a string table.
+ * @param table A pointer to an initialized string table.
+ * @return <implementation-defined>
+ */
+string_table_const_iter_t string_table_end(const string_table_t* table);
+
+/**
+ * Returns the iterator proceeding a given iterator.
+ * @param table A pointer to an initialized string table.
+ * @param iter A valid iterator excluding string_table_end(table) to the entry.
+ * @return The iterator proceeding the given iterator, string_table_end(table) on end reached.
+ */
+string_table_const_iter_t string_table_next(const string_table_t* table, string_table_const_iter_t iter);
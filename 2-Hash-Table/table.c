@@ -8,9 +8,14 @@ int key_compare(const table_key_t* key1, const table_key_t* key2)
 	return *key1 == *key2;
 }
 
+int key_less(const table_key_t* key1, const table_key_t* key2)
+{
+	return *key1 < *key2;
+}
+
 size_t key_hasher(const table_key_t* key)
 {
-	return *key;
+	return table_hash_mix(key, 0);
 }
 
 void key_duplicator(table_key_t* target, const table_key_t* key)
@@ -34,16 +39,185 @@ void value_destructor(table_value_t* value)
 }
 
 
+/* Hashers */
+
+#define XXH_PRIME1 UINT64_C(0x9E3779B185EBCA87)
+#define XXH_PRIME2 UINT64_C(0xC2B2AE3D27D4EB4F)
+#define XXH_PRIME3 UINT64_C(0x165667B19E3779F9)
+#define XXH_PRIME4 UINT64_C(0x85EBCA77C2B2AE63)
+#define XXH_PRIME5 UINT64_C(0x27D4EB2F165667C5)
+
+static uint64_t rotl64(uint64_t x, int r)
+{
+	return (x << r) | (x >> (64 - r));
+}
+
+static uint64_t read64(const unsigned char* p)
+{
+	return (uint64_t)p[0] | (uint64_t)p[1] << 8 | (uint64_t)p[2] << 16 | (uint64_t)p[3] << 24
+		| (uint64_t)p[4] << 32 | (uint64_t)p[5] << 40 | (uint64_t)p[6] << 48 | (uint64_t)p[7] << 56;
+}
+
+static uint64_t read32(const unsigned char* p)
+{
+	return (uint64_t)p[0] | (uint64_t)p[1] << 8 | (uint64_t)p[2] << 16 | (uint64_t)p[3] << 24;
+}
+
+static uint64_t fmix64(uint64_t x)
+{
+	x ^= x >> 33;
+	x *= UINT64_C(0xFF51AFD7ED558CCD);
+	x ^= x >> 33;
+	x *= UINT64_C(0xC4CEB9FE1A85EC53);
+	x ^= x >> 33;
+
+	return x;
+}
+
+static uint64_t xxh_round(uint64_t acc, uint64_t input)
+{
+	return rotl64(acc + input * XXH_PRIME2, 31) * XXH_PRIME1;
+}
+
+static uint64_t xxh_merge(uint64_t acc, uint64_t lane)
+{
+	return (acc ^ xxh_round(0, lane)) * XXH_PRIME1 + XXH_PRIME4;
+}
+
+size_t table_hash_mix(const table_key_t* key, uint64_t seed)
+{
+	/* the constant keeps key 0 with seed 0 away from the finalizer's fixed point */
+	return (size_t)fmix64((uint64_t)*key ^ seed ^ XXH_PRIME1);
+}
+
+size_t table_hash_key_bytes(const table_key_t* key, uint64_t seed)
+{
+	return (size_t)table_hash_bytes(key, sizeof(table_key_t), seed);
+}
+
+size_t table_hash_sip(const table_key_t* key, uint64_t seed)
+{
+	return (size_t)table_siphash(key, sizeof(table_key_t), seed, fmix64(seed ^ XXH_PRIME5));
+}
+
+uint64_t table_hash_bytes(const void* data, size_t len, uint64_t seed)
+{
+	const unsigned char* p = (const unsigned char*)data;
+	const unsigned char* end = p + len;
+	uint64_t hash;
+
+	if (len >= 32)
+	{
+		uint64_t lanes[4];
+		int i;
+
+		lanes[0] = seed + XXH_PRIME1 + XXH_PRIME2;
+		lanes[1] = seed + XXH_PRIME2;
+		lanes[2] = seed;
+		lanes[3] = seed - XXH_PRIME1;
+
+		do
+		{
+			for (i = 0; i < 4; ++i)
+				lanes[i] = xxh_round(lanes[i], read64(p + 8*i));
+
+			p += 32;
+		} while (end - p >= 32);
+
+		hash = rotl64(lanes[0], 1) + rotl64(lanes[1], 7) + rotl64(lanes[2], 12) + rotl64(lanes[3], 18);
+
+		for (i = 0; i < 4; ++i)
+			hash = xxh_merge(hash, lanes[i]);
+	}
+	else
+		hash = seed + XXH_PRIME5;
+
+	hash += (uint64_t)len;
+
+	for (; end - p >= 8; p += 8)
+		hash = rotl64(hash ^ xxh_round(0, read64(p)), 27) * XXH_PRIME1 + XXH_PRIME4;
+
+	if (end - p >= 4)
+	{
+		hash = rotl64(hash ^ read32(p) * XXH_PRIME1, 23) * XXH_PRIME2 + XXH_PRIME3;
+		p += 4;
+	}
+
+	for (; p < end; ++p)
+		hash = rotl64(hash ^ *p * XXH_PRIME5, 11) * XXH_PRIME1;
+
+	hash ^= hash >> 33;
+	hash *= XXH_PRIME2;
+	hash ^= hash >> 29;
+	hash *= XXH_PRIME3;
+	hash ^= hash >> 32;
+
+	return hash;
+}
+
+#define SIP_ROUND(v0, v1, v2, v3) \
+	v0 += v1; v1 = rotl64(v1, 13); v1 ^= v0; v0 = rotl64(v0, 32); \
+	v2 += v3; v3 = rotl64(v3, 16); v3 ^= v2; \
+	v0 += v3; v3 = rotl64(v3, 21); v3 ^= v0; \
+	v2 += v1; v1 = rotl64(v1, 17); v1 ^= v2; v2 = rotl64(v2, 32)
+
+uint64_t table_siphash(const void* data, size_t len, uint64_t k0, uint64_t k1)
+{
+	const unsigned char* p = (const unsigned char*)data;
+	const unsigned char* end = p + (len & ~(size_t)7);
+	uint64_t v0 = k0 ^ UINT64_C(0x736F6D6570736575);
+	uint64_t v1 = k1 ^ UINT64_C(0x646F72616E646F6D);
+	uint64_t v2 = k0 ^ UINT64_C(0x6C7967656E657261);
+	uint64_t v3 = k1 ^ UINT64_C(0x7465646279746573);
+	uint64_t m;
+	size_t i;
+
+	for (; p != end; p += 8)
+	{
+		m = read64(p);
+		v3 ^= m;
+		SIP_ROUND(v0, v1, v2, v3);
+		SIP_ROUND(v0, v1, v2, v3);
+		v0 ^= m;
+	}
+
+	m = (uint64_t)len << 56;
+
+	for (i = 0; i < (len & 7); ++i)
+		m |= (uint64_t)p[i] << (8*i);
+
+	v3 ^= m;
+	SIP_ROUND(v0, v1, v2, v3);
+	SIP_ROUND(v0, v1, v2, v3);
+	v0 ^= m;
+
+	v2 ^= 0xFF;
+	SIP_ROUND(v0, v1, v2, v3);
+	SIP_ROUND(v0, v1, v2, v3);
+	SIP_ROUND(v0, v1, v2, v3);
+	SIP_ROUND(v0, v1, v2, v3);
+
+	return v0 ^ v1 ^ v2 ^ v3;
+}
+
+
 /* Table interface implementation */
 
 void table_init(table_t* table);
 
+void table_init_config(table_t* table, const table_config_t* config);
+
 void table_free(table_t* table);
 
 void table_clear(table_t* table);
 
 size_t table_size(const table_t* table);
 
+int table_reserve(table_t* table, size_t n);
+int table_shrink_to_fit(table_t* table);
+
+size_t table_capacity(const table_t* table);
+
 table_iter_t table_insert(table_t* table, table_key_t* key, table_value_t* value,
 	storage_mode key_storage_mode, storage_mode value_storage_mode);
 
@@ -55,9 +229,21 @@ const table_value_t* table_value(const table_t* table, table_const_iter_t iter);
 
 table_iter_t table_assign(table_t* table, table_iter_t iter, table_value_t* value, storage_mode value_storage_mode);
 
+table_value_t* table_value_mut(table_t* table, table_iter_t iter);
+
+table_iter_t table_find_or_insert(table_t* table, table_key_t* key, storage_mode key_storage_mode, int* inserted);
+table_iter_t table_upsert(table_t* table, table_key_t* key, table_value_t* value,
+	storage_mode key_storage_mode, storage_mode value_storage_mode, int* inserted);
+
 table_const_iter_t table_find(const table_t* table, const table_key_t* key);
 table_iter_t table_find_mut(table_t* table, const table_key_t* key);
 
+void table_find_batch(const table_t* table, const table_key_t* const* keys, size_t n, table_const_iter_t* out);
+void table_insert_batch(table_t* table, table_key_t* const* keys, table_value_t* const* values, size_t n,
+	storage_mode key_storage_mode, storage_mode value_storage_mode, table_iter_t* out);
+size_t table_insert_bulk(table_t* table, table_key_t* const* keys, table_value_t* const* values, size_t n,
+	storage_mode key_storage_mode, storage_mode value_storage_mode, size_t* duplicates);
+
 table_const_iter_t table_begin(const table_t* table);
 table_iter_t table_begin_mut(table_t* table);
 
@@ -65,3 +251,41 @@ table_const_iter_t table_end(const table_t* table);
 
 table_const_iter_t table_next(const table_t* table, table_const_iter_t iter);
 table_iter_t table_next_mut(const table_t* table, table_iter_t iter);
+
+size_t table_partition(const table_t* table, size_t k, table_range_t out[]);
+
+table_const_iter_t table_range_begin(const table_t* table, const table_range_t* range);
+table_const_iter_t table_range_next(const table_t* table, const table_range_t* range, table_const_iter_t iter);
+
+void table_parallel_foreach(const table_t* table, table_callback_t callback, void* context, size_t thread_count);
+
+table_const_iter_t table_lower_bound(const table_t* table, const table_key_t* key);
+size_t table_range(const table_t* table, const table_key_t* lo, const table_key_t* hi, table_callback_t callback,
+	void* context);
+
+table_const_iter_t table_ordered_begin(const table_t* table);
+table_const_iter_t table_ordered_next(const table_t* table, table_const_iter_t iter);
+
+int table_freeze(table_t* table);
+int table_frozen(const table_t* table);
+
+int table_save(const table_t* table, const char* path);
+int table_open_mmap(table_t* table, const char* path, const table_config_t* config);
+
+int table_reader_register(const table_t* table, table_reader_t* reader);
+void table_reader_unregister(const table_t* table, table_reader_t* reader);
+
+void table_read_begin(const table_t* table, table_reader_t* reader);
+void table_read_end(const table_t* table, table_reader_t* reader);
+
+size_t table_reclaim(table_t* table);
+void table_synchronize(table_t* table);
+
+int table_reclaimer_init(table_reclaimer_t* reclaimer, int background);
+void table_reclaimer_free(table_reclaimer_t* reclaimer);
+size_t table_reclaim_step(table_reclaimer_t* reclaimer, size_t budget);
+
+#ifdef TABLE_STATS
+void table_stats(const table_t* table, table_stats_t* out);
+void table_stats_reset(table_t* table);
+#endif
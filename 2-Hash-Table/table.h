@@ -1,19 +1,22 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 
 /**
  * The table_t type implements a hash table.
  *
  * Implementation-defined specification:
- *   table_key_t: Type definition for keys in a table.
- *   value_type_t: Type definition for values in a table.
+ *   table_key_t: Type definition for keys in a table, TABLE_KEY_TYPE (int unless defined when compiling).
+ *   value_type_t: Type definition for values in a table, TABLE_VALUE_TYPE (int unless defined when compiling).
  *   key_compare: Function that compares two keys, returns 1 if identical, 0 otherwise.
+ *   key_less: Function that orders two keys, returns 1 if the first orders before the second, 0 otherwise.
  *   key_hasher: Function that maps an instance of table_key_t to an unsigned integral.
  *   key_duplicator: Function that duplicates an instance of table_key_t.
  *   key_destructor: Function that frees all memory associated with an instance of table_key_t.
  *   value_duplicator: Function that duplicates an instance of table_value_t.
  *   value_destructor: Function that frees all memory associated with an instance of table_value_t.
+ *   table_hasher_t: Seeded hash function type, selectable per table through table_config_t.
  *   table_t: Hash table structure type definition.
  *
  * Expectations:
@@ -21,38 +24,116 @@
  *    TRANSIENT specifies that a copy of the key or value will be made and its memory will be managed by the table.
  *    STATIC specifies that no copy of the key or value will be made and its memory must be managed by the user.
  *    TRANSFER specifies that no copy of the key or value will be made and its memory will be managed by the table.
+ *    MAPPED marks a key or value held inline in a node of a mapped image (see table_open_mmap). It is never passed to
+ *     the insertion functions, and its memory belongs to the mapping.
  *   The public interface ought not be mutated! The implementation may define more functions but must not alter the
  *    signature of any functions beloning to the public interface.
  *   Table and table nodes are not to be accessed or manipulated outside the interface.
+ *   Small keys and values are stored inline: when TABLE_INLINE_KEY (TABLE_INLINE_VALUE) is nonzero, a TRANSIENT key
+ *    (value) is duplicated into the node itself instead of a separate allocation, and table_key (table_value) returns a
+ *    pointer into the node. Inline copies are never passed to key_destructor (value_destructor), so the inline macros
+ *    must only be enabled for types that own no resources. They default to 1 only for the shipped int key (value)
+ *    type, a type supplied through TABLE_KEY_TYPE (TABLE_VALUE_TYPE) is stored out of line unless TABLE_INLINE_KEY
+ *    (TABLE_INLINE_VALUE) is explicitly defined to 1. Nodes should reside directly in the bucket array so that a
+ *    lookup followed by a read touches a single cache line.
  *
  * There is no expectation for any particular hash table implementation to handle collisions, however collisions
  *  MUST be handled by the implementation.
  *
- * All functions aside from table_init expect an initialized table, providing an uninitialized table shall be undefined
- *  behavior.
- * The function table_init expects an uninitialized table, providing an initialized table shall be undefined behavior.
+ * All functions aside from the initializers expect an initialized table, providing an uninitialized table shall be
+ *  undefined behavior.
+ * The functions table_init, table_init_config, and table_open_mmap expect an uninitialized table, providing an
+ *  initialized table shall be undefined behavior.
  * Passing iterators to functions that are invalidated (from removing, rehashing, etc.) shall be undefined behavior.
  */
 
-typedef int table_key_t;
-typedef int table_value_t;
+#ifndef TABLE_KEY_TYPE
+	#define TABLE_KEY_TYPE int
+	#define TABLE_KEY_SHIPPED 1
+#endif
+
+#ifndef TABLE_VALUE_TYPE
+	#define TABLE_VALUE_TYPE int
+	#define TABLE_VALUE_SHIPPED 1
+#endif
+
+typedef TABLE_KEY_TYPE table_key_t;
+typedef TABLE_VALUE_TYPE table_value_t;
 
 extern int key_compare(const table_key_t* key1, const table_key_t* key2);
+extern int key_less(const table_key_t* key1, const table_key_t* key2);
 extern size_t key_hasher(const table_key_t* key);
 extern void key_duplicator(table_key_t* target, const table_key_t* key);
 extern void key_destructor(table_key_t* key);
 extern void value_duplicator(table_value_t* target, const table_value_t* value);
 extern void value_destructor(table_value_t* value);
 
+typedef size_t (*table_hasher_t)(const table_key_t* key, uint64_t seed);
+
+/**
+ * Integer mixer (murmur3 finalizer) for integral keys.
+ * Spreads sequential and strided keys over all bits, so they do not cluster in power-of-two tables.
+ */
+size_t table_hash_mix(const table_key_t* key, uint64_t seed);
+
+/**
+ * Byte-wise hash of the object representation of a key, see table_hash_bytes.
+ * Assumes table_key_t has no padding bits.
+ */
+size_t table_hash_key_bytes(const table_key_t* key, uint64_t seed);
+
+/**
+ * Keyed hash (SipHash-2-4) of the object representation of a key, resistant to hash-flooding as long as the seed is
+ *  random and kept secret.
+ */
+size_t table_hash_sip(const table_key_t* key, uint64_t seed);
+
+/**
+ * Hashes an arbitrary byte string (XXH64).
+ * Input is consumed 32 bytes at a time in four independent 64-bit lanes, whose multiply chains do not depend on each
+ *  other so the processor overlaps them (the 64-bit multiplies stay scalar, they are not vectorized).
+ */
+uint64_t table_hash_bytes(const void* data, size_t len, uint64_t seed);
+
+/**
+ * Computes SipHash-2-4 of an arbitrary byte string with the 128-bit key (k0, k1).
+ */
+uint64_t table_siphash(const void* data, size_t len, uint64_t k0, uint64_t k1);
+
+#ifndef TABLE_INLINE_KEY
+	#ifdef TABLE_KEY_SHIPPED
+		#define TABLE_INLINE_KEY 1
+	#else
+		#define TABLE_INLINE_KEY 0
+	#endif
+#endif
+
+#ifndef TABLE_INLINE_VALUE
+	#ifdef TABLE_VALUE_SHIPPED
+		#define TABLE_INLINE_VALUE 1
+	#else
+		#define TABLE_INLINE_VALUE 0
+	#endif
+#endif
+
 typedef enum storage_mode
 {
-	TRANSIENT, STATIC, TRANSFER
+	TRANSIENT, STATIC, TRANSFER, MAPPED
 } storage_mode;
 
 typedef struct table_node_t
 {
-	table_key_t* key;
-	table_value_t* value;
+	union
+	{
+		table_key_t* ptr; /* STATIC, TRANSFER, or TRANSIENT when !TABLE_INLINE_KEY */
+		table_key_t local; /* TRANSIENT when TABLE_INLINE_KEY, or MAPPED */
+	} key;
+
+	union
+	{
+		table_value_t* ptr; /* STATIC, TRANSFER, or TRANSIENT when !TABLE_INLINE_VALUE */
+		table_value_t local; /* TRANSIENT when TABLE_INLINE_VALUE, or MAPPED */
+	} value;
 
 	storage_mode key_storage_type;
 	storage_mode value_storage_type;
@@ -61,17 +142,282 @@ typedef struct table_node_t
 typedef table_node_t* table_iter_t;
 typedef const table_node_t* table_const_iter_t;
 
+/**
+ * A disjoint range of slots [first, last) produced by table_partition.
+ */
+typedef struct table_range_t
+{
+	size_t first;
+	size_t last;
+} table_range_t;
+
+/**
+ * Entry layouts of a table.
+ *   TABLE_LAYOUT_DEFAULT: Implementation-defined layout.
+ *   TABLE_LAYOUT_DENSE: Entries are stored in a dense array in insertion order, and the hash index only holds the
+ *    position of each entry in that array (using the narrowest integer type that can address it). Iteration is a
+ *    linear scan of the dense array and always follows insertion order. table_erase leaves a hole at the erased
+ *    position and returns the iterator of the next live entry, table_next and table_begin skip holes, and
+ *    table_end(table) is one past the last used position. Every rehash (growth, shrinking, or the tombstone purge
+ *    described under shrink_load, which counts holes as tombstones) compacts the array, preserving the order.
+ */
+typedef enum table_layout_t
+{
+	TABLE_LAYOUT_DEFAULT, TABLE_LAYOUT_DENSE
+} table_layout_t;
+
+/**
+ * Collision handling engines of a table.
+ *   TABLE_ENGINE_DEFAULT: Implementation-defined engine with expected-constant lookups.
+ *   TABLE_ENGINE_CUCKOO: Bucketized cuckoo hashing with a hard worst case. Every key has two candidate buckets derived
+ *    from its single hash (partial-key cuckoo hashing), so they differ even under the default seedless hasher: the
+ *    first bucket comes from the low bits of the hash, an 8-bit fingerprint from bits not used for the bucket index,
+ *    and the second bucket is the first XORed with a mix of the fingerprint forced odd (the bucket count is a power of
+ *    two), so the two never coincide and a relocated entry finds its other bucket from its fingerprint alone, without
+ *    rehashing its key. Each bucket holds cuckoo_slots entries. When TABLE_INLINE_KEY is nonzero and
+ *    cuckoo_slots * (1 + sizeof(table_key_t)) is at most 64, a bucket is a single 64-byte aligned line holding one
+ *    fingerprint per slot followed by copies of the slots' keys, and the nodes live in a parallel array: a lookup, hit
+ *    or miss, reads at most these 2 lines, compares keys only where fingerprints match, and touches the node line only
+ *    when the caller reads the entry. Otherwise buckets keep only their fingerprints in the 64-byte line and the bound
+ *    holds for misses alone, a hit also reading the node lines of the matching slots. Inserts relocate entries along
+ *    the shortest eviction path found by breadth-first search, entries that cannot be placed within the search bound go
+ *    to a stash of cuckoo_stash entries (laid out as one bucket, and read by lookups only while non-empty, adding one
+ *    line), and the table grows once the stash is full. Ignored by TABLE_LAYOUT_DENSE.
+ */
+typedef enum table_engine_t
+{
+	TABLE_ENGINE_DEFAULT, TABLE_ENGINE_CUCKOO
+} table_engine_t;
+
+/**
+ * Concurrency modes of a table.
+ *   TABLE_CONCURRENCY_NONE: No concurrent access is supported.
+ *   TABLE_CONCURRENCY_EPOCH: Lock-free reads with epoch-based reclamation. Any number of reader threads may run
+ *    table_find, table_begin, table_next, table_end, table_key, table_value, and table_size inside a read-side
+ *    critical section (table_read_begin, table_read_end) concurrently with one writer at a time (writers must be
+ *    serialized by the caller). Readers never write memory shared with other threads, the only store of a reader goes
+ *    to its own cache-line padded epoch slot. Writers publish new slots and new bucket arrays with release stores, and
+ *    readers load them with acquire loads. Erased or replaced nodes, old bucket arrays, and the key_destructor and
+ *    value_destructor calls they imply are retired to the current epoch and only run once every registered reader has
+ *    left the critical sections that began in that epoch, so pointers obtained inside a critical section stay valid
+ *    until it ends. Values are never written in place under readers: table_assign and a replacing table_upsert
+ *    publish a new node holding the new value and retire the old one, and table_value_mut shall not be used on such a
+ *    table. This mode is built on C11 <stdatomic.h> (table sources are compiled with -std=c11) and POSIX threads.
+ */
+typedef enum table_concurrency_t
+{
+	TABLE_CONCURRENCY_NONE, TABLE_CONCURRENCY_EPOCH
+} table_concurrency_t;
+
+/**
+ * Page backing of a table's bucket and slot arrays.
+ *   TABLE_PAGES_DEFAULT: Arrays come from malloc.
+ *   TABLE_PAGES_HUGE: Arrays of at least 2MB are mapped with mmap, rounded up and aligned to 2MB, and advised with
+ *    madvise(MADV_HUGEPAGE) so the kernel backs them with huge pages, cutting TLB misses on large tables. If mapping
+ *    or advising fails, or the platform has no such facility, the table silently falls back to malloc.
+ */
+typedef enum table_pages_t
+{
+	TABLE_PAGES_DEFAULT, TABLE_PAGES_HUGE
+} table_pages_t;
+
+/**
+ * NUMA placement of a table's bucket and slot arrays.
+ *   TABLE_NUMA_DEFAULT: Operating system default, pages land on the node of the thread that first touches them.
+ *   TABLE_NUMA_INTERLEAVE: Pages are interleaved over all nodes with mbind(MPOL_INTERLEAVE) (issued as a system call,
+ *    libnuma is not required), so threads on every socket see the same average latency.
+ *   TABLE_NUMA_FIRST_TOUCH: Newly allocated arrays are initialized in parallel by numa_threads threads, each touching
+ *    a contiguous share, so pages are spread over the nodes those threads run on.
+ *   Placement requests that the platform rejects fall back to TABLE_NUMA_DEFAULT.
+ */
+typedef enum table_numa_t
+{
+	TABLE_NUMA_DEFAULT, TABLE_NUMA_INTERLEAVE, TABLE_NUMA_FIRST_TOUCH
+} table_numa_t;
+
+/**
+ * Membership filters kept alongside a table to answer misses without probing it. The filter is derived from bits of
+ *  the key's hash not used for the bucket index, so it costs no extra hashing, and is sized from filter_bits_per_key
+ *  whenever the table grows or shrinks. table_find, table_find_mut, table_find_batch, and the duplicate checks of the
+ *  insertion functions return (or proceed) without touching the table when the filter rules a key out.
+ *   TABLE_FILTER_NONE: No filter.
+ *   TABLE_FILTER_BLOCKED_BLOOM: Blocked Bloom filter, every key sets its bits within a single 64-byte block, so a check
+ *    costs one cache miss. Erased keys cannot be removed, their bits are only cleared when the filter is rebuilt by
+ *    a rehash, so heavy erasure raises the false positive rate until then.
+ *   TABLE_FILTER_QUOTIENT: Counting quotient filter, which supports removal on erasure. Checks scan one run of
+ *    remainders that starts in the key's canonical block and rarely crosses a cache line.
+ */
+typedef enum table_filter_t
+{
+	TABLE_FILTER_NONE, TABLE_FILTER_BLOCKED_BLOOM, TABLE_FILTER_QUOTIENT
+} table_filter_t;
+
+/**
+ * Ordered secondary indexes over the keys of a table, maintained by every function that inserts or erases entries.
+ *   TABLE_INDEX_NONE: No ordered index, the ordered functions shall not be used.
+ *   TABLE_INDEX_BTREE: Cache-conscious B+tree ordered by key_less, whose nodes span a few cache lines (keys stored
+ *    separately from child pointers so a node search scans contiguous keys) and whose leaves hold iterators and are
+ *    linked for range scans. Rehashing moves entries, so it updates the iterators held by the leaves.
+ */
+typedef enum table_index_t
+{
+	TABLE_INDEX_NONE, TABLE_INDEX_BTREE
+} table_index_t;
+
+typedef struct table_reclaimer_t
+{
+	/* implementation defined, queue of detached table storage awaiting destruction */
+} table_reclaimer_t;
+
+#define TABLE_MIN_CAPACITY 8
+
+/**
+ * Per-table configuration, a zero-initialized table_config_t selects the default for every option.
+ *   hasher: The hash function of the table, NULL selects key_hasher (with the seed ignored).
+ *   seed: The seed passed to hasher.
+ *   layout: The entry layout of the table.
+ *   engine: The collision handling engine of the table.
+ *   cuckoo_slots: Entries per bucket for TABLE_ENGINE_CUCKOO, 4 to 8, 0 selects 4.
+ *   cuckoo_stash: Stash entries for TABLE_ENGINE_CUCKOO, 0 selects 4.
+ *   concurrency: The concurrency mode of the table.
+ *   reclaimer: Deferred destruction for table_clear and table_free, NULL destroys entries immediately. When set, both
+ *    functions detach the current storage in O(1) (leaving an empty table, or an uninitialized one for table_free) and
+ *    queue it on the reclaimer, which later calls key_destructor and value_destructor for its TRANSFER and non-inline
+ *    TRANSIENT keys and values and releases the storage. STATIC keys and values and inline copies are never passed to
+ *    the destructors, and storage holding no owned keys or values (tracked by a per-table count) is released without
+ *    visiting its entries. With a background reclaimer the destructors run on its thread, concurrently with the rest
+ *    of the program, so they must be thread-safe.
+ *   shrink_load: Load factor under which the table shrinks, 0 selects 1/8 and a negative value disables automatic
+ *    shrinking. A shrink picks the capacity that brings the load factor back to half the growth threshold, so the
+ *    table cannot regrow or shrink again until its size changes by a constant factor, but it never goes below
+ *    TABLE_MIN_CAPACITY slots nor below the reserve floor: the capacity needed for the largest n passed to
+ *    table_reserve since the last table_shrink_to_fit, which alone clears the floor. Shrinking, like growing, is only
+ *    performed by a call of table_insert, table_insert_batch, table_insert_bulk, table_find_or_insert, or table_upsert
+ *    that actually inserts an entry, before the entry is placed and judged by the size the table will have after the
+ *    call. It is never performed by table_erase, so erasing while iterating stays safe, nor by a call that only finds
+ *    or replaces existing entries, so those never invalidate iterators. The same inserting calls rehash the table at
+ *    its current capacity once erased-entry markers (tombstones) exceed a quarter of the slots, and every rehash
+ *    purges them.
+ *   pages: The page backing of the bucket and slot arrays.
+ *   numa: The NUMA placement of the bucket and slot arrays.
+ *   numa_threads: Threads used by TABLE_NUMA_FIRST_TOUCH, 0 selects the number of online processors.
+ *   filter: The membership filter of the table.
+ *   filter_bits_per_key: Filter bits per entry, trading memory for false positive rate, 0 selects 10.
+ *   index: The ordered index of the table.
+ */
+typedef struct table_config_t
+{
+	table_hasher_t hasher;
+	uint64_t seed;
+	table_layout_t layout;
+	table_engine_t engine;
+	size_t cuckoo_slots;
+	size_t cuckoo_stash;
+	table_concurrency_t concurrency;
+	table_reclaimer_t* reclaimer;
+	double shrink_load;
+	table_pages_t pages;
+	table_numa_t numa;
+	size_t numa_threads;
+	table_filter_t filter;
+	double filter_bits_per_key;
+	table_index_t index;
+} table_config_t;
+
+#define TABLE_IMAGE_MAGIC "TBLIMAGE"
+#define TABLE_IMAGE_VERSION 1
+
+/**
+ * Header of an on-disk table image written by table_save, all offsets are in bytes from the start of the file and
+ *  aligned to 64 bytes. The image is position-independent and in native byte order.
+ *   magic: TABLE_IMAGE_MAGIC without the null terminator.
+ *   version: TABLE_IMAGE_VERSION.
+ *   node_size: sizeof(table_node_t) of the writer.
+ *   seed: The seed of the table's hasher.
+ *   hasher_check: The table's hash of a key whose bytes are all zero, used to reject mismatched hashers.
+ *   size: The number of entries.
+ *   index_count: The number of index slots, a power of two.
+ *   index_offset: Offset of index_count uint64_t slots, 0 for an empty slot or the node position plus one.
+ *   nodes_offset: Offset of size table_node_t entries holding their key and value inline (in .local) and marked
+ *    MAPPED.
+ */
+typedef struct table_image_header_t
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t node_size;
+	uint64_t seed;
+	uint64_t hasher_check;
+	uint64_t size;
+	uint64_t index_count;
+	uint64_t index_offset;
+	uint64_t nodes_offset;
+} table_image_header_t;
+
+#ifdef TABLE_STATS
+
+#define TABLE_STATS_PROBE_LENGTHS 16
+
+/**
+ * Instrumentation counters of a table, only available when compiled with TABLE_STATS defined. Without TABLE_STATS
+ *  the table must not maintain any of these counters.
+ *   size: The number of entries.
+ *   capacity: The number of slots.
+ *   load_factor: size / capacity.
+ *   probe_lengths: Histogram of lookups by the number of slots probed, the last bin counts longer probes too.
+ *   tombstones: The number of slots holding an erased entry marker.
+ *   resizes: The number of times the slot array was reallocated.
+ *   resize_seconds: The total time spent reallocating and rehashing.
+ *   transient_bytes: The bytes allocated to hold TRANSIENT copies made through key_duplicator and value_duplicator.
+ *   lookups: The number of lookups (finds, inserts' duplicate checks, and batched variants).
+ *   key_compares: The number of key_compare calls made by those lookups.
+ *   huge_page_bytes: The bytes of the bucket and slot arrays mapped for huge pages (0 after a fallback).
+ *   filter_rejects: The number of lookups answered by the membership filter alone.
+ */
+typedef struct table_stats_t
+{
+	size_t size;
+	size_t capacity;
+	double load_factor;
+	size_t probe_lengths[TABLE_STATS_PROBE_LENGTHS];
+	size_t tombstones;
+	size_t resizes;
+	double resize_seconds;
+	size_t transient_bytes;
+	size_t lookups;
+	size_t key_compares;
+	size_t huge_page_bytes;
+	size_t filter_rejects;
+} table_stats_t;
+
+#endif
+
 typedef struct table_t
 {
 	/* implementation defined, use table_node_t for entries */
 } table_t;
 
+typedef void (*table_callback_t)(const table_t* table, table_const_iter_t iter, void* context);
+
+typedef struct table_reader_t
+{
+	/* implementation defined, a reader's epoch slot for TABLE_CONCURRENCY_EPOCH */
+} table_reader_t;
+
 /**
  * Initializes the given table.
  * @param table A pointer to an uninitialized table.
  */
 void table_init(table_t* table);
 
+/**
+ * Initializes the given table with a configuration.
+ * table_init(table) is equivalent to passing a zero-initialized configuration.
+ * @param table A pointer to an uninitialized table.
+ * @param config A pointer to the configuration, which is copied.
+ */
+void table_init_config(table_t* table, const table_config_t* config);
+
 /**
  * Releases resources used by the given table.
  * The table will become in an uninitialized state after this call.
@@ -92,6 +438,32 @@ void table_clear(table_t* table);
  */
 size_t table_size(const table_t* table);
 
+/**
+ * Grows the given table so that it can hold a number of entries without growing again, and raises its reserve floor
+ *  (see shrink_load) so automatic shrinking keeps room for them.
+ * Never shrinks the table, iterators are invalidated if the table grew.
+ * @param table A pointer to an initialized table.
+ * @param n The number of entries to make room for.
+ * @return 1 on success, 0 on allocation failure in which case the table is left unchanged.
+ */
+int table_reserve(table_t* table, size_t n);
+
+/**
+ * Shrinks the given table to the smallest capacity that holds its entries below the growth threshold, at least
+ *  TABLE_MIN_CAPACITY slots, purging tombstones and clearing the reserve floor set by table_reserve. Iterators are
+ *  invalidated.
+ * @param table A pointer to an initialized table.
+ * @return 1 on success, 0 on allocation failure in which case the table is left unchanged.
+ */
+int table_shrink_to_fit(table_t* table);
+
+/**
+ * Returns the number of slots of the given table.
+ * @param table A pointer to an initialized table.
+ * @return The number of entries the table can address before its load factor reaches 1.
+ */
+size_t table_capacity(const table_t* table);
+
 /**
  * Inserts a key-value pair into the table.
  * If the key already exists in the table, the insertion is a failure.
@@ -139,6 +511,51 @@ const table_value_t* table_value(const table_t* table, table_const_iter_t iter);
  */
 table_iter_t table_assign(table_t* table, table_iter_t iter, table_value_t* value, storage_mode value_storage_mode);
 
+/**
+ * Returns the mutable value associated with an iterator, for updating a value in place.
+ * Passing a TABLE_CONCURRENCY_EPOCH table, whose readers may read the value concurrently, or a frozen table (including
+ *  a mapped one) shall be undefined behavior.
+ * @param table A pointer to an initialized table.
+ * @param iter A valid iterator excluding table_end(table) to the entry to access.
+ * @return A pointer to the value associated with the iterator.
+ */
+table_value_t* table_value_mut(table_t* table, table_iter_t iter);
+
+/**
+ * Returns the entry of a key, inserting it first if it does not exist, with a single hash and probe sequence.
+ * A newly inserted entry holds a TRANSIENT value whose bytes are all zero.
+ * The key is only taken by the table when an entry is inserted, otherwise (including on failure) its memory remains
+ *  managed by the caller, which must then release a TRANSFER key itself.
+ * Iterators are invalidated if an entry was inserted.
+ * @param table A pointer to an initialized table.
+ * @param key A pointer to the key.
+ * @param key_storage_mode The storage mode of the key.
+ * @param inserted A pointer receiving 1 if the entry was inserted and 0 if it already existed, may only be NULL if
+ *  key_storage_mode is not TRANSFER.
+ * @return The iterator of the entry, table_end(table) on allocation failure.
+ */
+table_iter_t table_find_or_insert(table_t* table, table_key_t* key, storage_mode key_storage_mode, int* inserted);
+
+/**
+ * Inserts a key-value pair or replaces the value of an existing key in place, with a single hash and probe sequence.
+ * A replaced value is released according to its own storage mode exactly as table_assign would, and on a
+ *  TABLE_CONCURRENCY_EPOCH table the replacement is published as a new node and the old one retired.
+ * Passing a frozen table (including a mapped one) shall be undefined behavior.
+ * The key is only taken by the table when an entry is inserted, otherwise (including on failure) its memory remains
+ *  managed by the caller, which must then release a TRANSFER key itself.
+ * Iterators are invalidated if an entry was inserted.
+ * @param table A pointer to an initialized table.
+ * @param key A pointer to the key.
+ * @param value A pointer to the value.
+ * @param key_storage_mode The storage mode of the key.
+ * @param value_storage_mode The storage mode of the value.
+ * @param inserted A pointer receiving 1 if the entry was inserted and 0 if its value was replaced, may only be NULL
+ *  if key_storage_mode is not TRANSFER.
+ * @return The iterator of the entry, table_end(table) on allocation failure.
+ */
+table_iter_t table_upsert(table_t* table, table_key_t* key, table_value_t* value,
+	storage_mode key_storage_mode, storage_mode value_storage_mode, int* inserted);
+
 /**
  * Returns the iterator associated to an entry.
  * @param table A pointer to an initialized table.
@@ -155,6 +572,54 @@ table_const_iter_t table_find(const table_t* table, const table_key_t* key);
  */
 table_iter_t table_find_mut(table_t* table, const table_key_t* key);
 
+/**
+ * Returns the iterators associated to a batch of entries.
+ * All keys are hashed and their buckets prefetched before any entry is resolved (group prefetching or interleaved
+ *  probing), so that the cache misses of the batch overlap instead of being paid one after another.
+ * @param table A pointer to an initialized table.
+ * @param keys An array of n pointers to keys.
+ * @param n The number of keys.
+ * @param out An array of n iterators, out[i] receives the iterator of keys[i] if found, table_end(table) otherwise.
+ */
+void table_find_batch(const table_t* table, const table_key_t* const* keys, size_t n, table_const_iter_t* out);
+
+/**
+ * Inserts a batch of key-value pairs into the table.
+ * The pairs are inserted as if by calling table_insert on each in order (a key repeated within the batch fails after
+ *  its first occurrence), but hashing and prefetching are done for the whole batch up front like table_find_batch.
+ * The table is grown once before placement, so every iterator written to out is valid after the call.
+ * @param table A pointer to an initialized table.
+ * @param keys An array of n pointers to keys.
+ * @param values An array of n pointers to values.
+ * @param n The number of key-value pairs.
+ * @param key_storage_mode The storage mode of every key.
+ * @param value_storage_mode The storage mode of every value.
+ * @param out An array of n iterators, out[i] receives the iterator of the entry inserted for keys[i],
+ *  table_end(table) on failure.
+ */
+void table_insert_batch(table_t* table, table_key_t* const* keys, table_value_t* const* values, size_t n,
+	storage_mode key_storage_mode, storage_mode value_storage_mode, table_iter_t* out);
+
+/**
+ * Inserts a large number of key-value pairs into the table.
+ * The table is reserved for table_size(table) + n entries once, all keys are hashed in a tight loop, and entries are
+ *  placed with a radix-partitioned scatter on the high hash bits so each partition's buckets stay cache-resident.
+ * A key that already exists in the table or repeats an earlier key of the same call is not inserted, and the
+ *  memory of a TRANSFER key or value that is not inserted remains managed by the caller.
+ * Iterators are invalidated.
+ * @param table A pointer to an initialized table.
+ * @param keys An array of n pointers to keys.
+ * @param values An array of n pointers to values.
+ * @param n The number of key-value pairs.
+ * @param key_storage_mode The storage mode of every key.
+ * @param value_storage_mode The storage mode of every value.
+ * @param duplicates An array of at least n indices receiving, in increasing order, the index of every pair that was
+ *  not inserted, may be NULL.
+ * @return The number of pairs that were not inserted.
+ */
+size_t table_insert_bulk(table_t* table, table_key_t* const* keys, table_value_t* const* values, size_t n,
+	storage_mode key_storage_mode, storage_mode value_storage_mode, size_t* duplicates);
+
 /**
  * Returns the iterator associated to the first entry in a table.
  * @param table A pointer to an initialized table.
@@ -172,7 +637,7 @@ table_iter_t table_begin_mut(table_t* table);
 /**
  * Returns the iterator associated to the end of a table.
  * @param table A pointer to an initialized table.
- * @return <implementation-defined>
+ * @return One past the last used position for TABLE_LAYOUT_DENSE, <implementation-defined> otherwise.
  */
 table_const_iter_t table_end(const table_t* table);
 
@@ -191,3 +656,219 @@ table_const_iter_t table_next(const table_t* table, table_const_iter_t iter);
  * @return The iterator proceeding the given iterator, table_end(table) on end reached.
  */
 table_iter_t table_next_mut(const table_t* table, table_iter_t iter);
+
+/**
+ * Splits the slot space of the table into disjoint ranges of roughly equal slot counts that together cover every
+ *  entry exactly once, for scanning in parallel.
+ * Ranges are invalidated like iterators.
+ * @param table A pointer to an initialized table.
+ * @param k The maximum number of ranges.
+ * @param out An array of at least k ranges receiving the ranges.
+ * @return The number of ranges written, less than k only when the table has fewer than k slots.
+ */
+size_t table_partition(const table_t* table, size_t k, table_range_t out[]);
+
+/**
+ * Returns the iterator associated to the first entry in a range.
+ * @param table A pointer to an initialized table.
+ * @param range A pointer to a range produced by table_partition.
+ * @return The iterator of the first entry of the range, table_end(table) on empty range.
+ */
+table_const_iter_t table_range_begin(const table_t* table, const table_range_t* range);
+
+/**
+ * Returns the iterator proceeding a given iterator within a range.
+ * @param table A pointer to an initialized table.
+ * @param range A pointer to a range produced by table_partition.
+ * @param iter A valid iterator of the range excluding table_end(table).
+ * @return The iterator proceeding the given iterator, table_end(table) on end of range reached.
+ */
+table_const_iter_t table_range_next(const table_t* table, const table_range_t* range, table_const_iter_t iter);
+
+/**
+ * Invokes a callback for every entry using a pool of threads (POSIX threads).
+ * The slot space is cut into many more chunks than threads, each thread first scans the chunks of its own contiguous
+ *  share and then steals remaining chunks from the other shares, so uneven entry density does not leave threads idle.
+ * The table must not be modified until the call returns.
+ * @param table A pointer to an initialized table.
+ * @param callback The function to invoke, it may run on any of the threads and concurrently with itself.
+ * @param context Passed to every invocation of the callback.
+ * @param thread_count The number of threads, 0 selects the number of online processors.
+ */
+void table_parallel_foreach(const table_t* table, table_callback_t callback, void* context, size_t thread_count);
+
+/**
+ * Returns the iterator associated to the first entry, in key order, whose key does not order before a given key.
+ * Requires an ordered index, costs O(log n).
+ * @param table A pointer to an initialized table.
+ * @param key A pointer to the key.
+ * @return The iterator of the entry if found, table_end(table) if every key orders before the given key.
+ */
+table_const_iter_t table_lower_bound(const table_t* table, const table_key_t* key);
+
+/**
+ * Invokes a callback, in key order, for every entry whose key lies in [lo, hi).
+ * Requires an ordered index, costs O(log n + k) for k visited entries.
+ * The table must not be modified until the call returns.
+ * @param table A pointer to an initialized table.
+ * @param lo A pointer to the inclusive lower bound.
+ * @param hi A pointer to the exclusive upper bound.
+ * @param callback The function to invoke.
+ * @param context Passed to every invocation of the callback.
+ * @return The number of entries visited.
+ */
+size_t table_range(const table_t* table, const table_key_t* lo, const table_key_t* hi, table_callback_t callback,
+	void* context);
+
+/**
+ * Returns the iterator associated to the entry with the smallest key.
+ * Requires an ordered index.
+ * @param table A pointer to an initialized table.
+ * @return The iterator of the first entry in key order, table_end(table) on empty table.
+ */
+table_const_iter_t table_ordered_begin(const table_t* table);
+
+/**
+ * Returns the iterator associated to the entry whose key follows the key of a given iterator.
+ * Requires an ordered index, costs O(log n) in the worst case (table_range walks the leaves directly).
+ * @param table A pointer to an initialized table.
+ * @param iter A valid iterator excluding table_end(table) to the entry.
+ * @return The iterator of the next entry in key order, table_end(table) on end reached.
+ */
+table_const_iter_t table_ordered_next(const table_t* table, table_const_iter_t iter);
+
+/**
+ * Freezes the given table into an immutable minimal perfect-hash layout.
+ * Keys and values are packed contiguously and a displacement array of a few bits per key (CHD/PTHash style) maps
+ *  every stored key to its own slot, so table_find resolves any key with exactly one probe and one key_compare.
+ * Iterators are invalidated. table_find, table_find_mut, table_begin, table_begin_mut, table_next, table_next_mut,
+ *  table_end, table_key, table_value, table_size, table_clear, and table_free keep working on a frozen table,
+ *  table_insert, table_reserve, and table_shrink_to_fit fail (return table_end(table) or 0) leaving the table
+ *  unchanged, table_insert_batch writes table_end(table) for every key, table_insert_bulk inserts nothing and reports
+ *  every pair as not inserted, and table_find_or_insert returns table_end(table) when the key is missing. Passing a
+ *  frozen table to table_erase, table_assign, table_value_mut, or table_upsert shall be undefined behavior, since they
+ *  would write into the packed (or, for table_open_mmap, read-only) entries.
+ * A cleared frozen table is no longer frozen.
+ * @param table A pointer to an initialized table.
+ * @return 1 on success, 0 on failure in which case the table is left unchanged.
+ */
+int table_freeze(table_t* table);
+
+/**
+ * Returns whether the given table is frozen.
+ * @param table A pointer to an initialized table.
+ * @return 1 if the table was frozen by table_freeze, 0 otherwise.
+ */
+int table_frozen(const table_t* table);
+
+/**
+ * Writes an image of the given table to a file, see table_image_header_t.
+ * Keys and values are written by value, so this requires TABLE_INLINE_KEY and TABLE_INLINE_VALUE and key and value
+ *  types that hold no pointers.
+ * @param table A pointer to an initialized table.
+ * @param path The path of the file to create or overwrite.
+ * @return 1 on success, 0 on failure.
+ */
+int table_save(const table_t* table, const char* path);
+
+/**
+ * Initializes the given table from an image written by table_save, mapping the file read-only (POSIX mmap).
+ * Lookups are served directly from the mapping with no deserialization, so opening costs O(1) regardless of size.
+ * The table behaves as a frozen table (see table_freeze) whose entries are all MAPPED, table_key and table_value
+ *  return pointers to the inline copies in the mapping, no destructor is ever called for them, and table_free or
+ *  table_clear unmap the file.
+ * @param table A pointer to an uninitialized table.
+ * @param path The path of the image.
+ * @param config A pointer to the configuration the image was saved with, NULL for the default.
+ * @return 1 on success, 0 on failure (missing file, bad header, or mismatched hasher) leaving the table
+ *  uninitialized.
+ */
+int table_open_mmap(table_t* table, const char* path, const table_config_t* config);
+
+/**
+ * Registers a reader with a TABLE_CONCURRENCY_EPOCH table, each reading thread needs its own reader.
+ * @param table A pointer to an initialized table.
+ * @param reader A pointer to an unregistered reader.
+ * @return 1 on success, 0 on failure.
+ */
+int table_reader_register(const table_t* table, table_reader_t* reader);
+
+/**
+ * Unregisters a reader, which must not be inside a read-side critical section.
+ * @param table A pointer to an initialized table.
+ * @param reader A pointer to a reader registered with the table.
+ */
+void table_reader_unregister(const table_t* table, table_reader_t* reader);
+
+/**
+ * Enters a read-side critical section, publishing the current epoch in the reader's slot.
+ * Critical sections must not nest.
+ * @param table A pointer to an initialized table.
+ * @param reader A pointer to a reader registered with the table.
+ */
+void table_read_begin(const table_t* table, table_reader_t* reader);
+
+/**
+ * Leaves a read-side critical section, iterators and pointers obtained inside it are invalidated.
+ * @param table A pointer to an initialized table.
+ * @param reader A pointer to a reader registered with the table.
+ */
+void table_read_end(const table_t* table, table_reader_t* reader);
+
+/**
+ * Runs the retired work of every epoch that all registered readers have left, called by writers.
+ * Writers also reclaim opportunistically during modifications.
+ * @param table A pointer to an initialized table.
+ * @return The number of retired nodes and arrays still awaiting reclamation.
+ */
+size_t table_reclaim(table_t* table);
+
+/**
+ * Blocks until every critical section that began before the call has ended, then reclaims all retired work.
+ * @param table A pointer to an initialized table.
+ */
+void table_synchronize(table_t* table);
+
+/**
+ * Initializes a reclaimer for deferred table destruction.
+ * @param reclaimer A pointer to an uninitialized reclaimer.
+ * @param background 1 to drain the queue on a dedicated background thread (POSIX threads), which then calls
+ *  key_destructor and value_destructor, 0 to only make progress through table_reclaim_step.
+ * @return 1 on success, 0 on failure leaving the reclaimer uninitialized.
+ */
+int table_reclaimer_init(table_reclaimer_t* reclaimer, int background);
+
+/**
+ * Finishes all queued work, stops the background thread if any, and releases the reclaimer.
+ * Every table configured with the reclaimer must have been freed beforehand.
+ * The reclaimer will become in an uninitialized state after this call.
+ * @param reclaimer A pointer to an initialized reclaimer.
+ */
+void table_reclaimer_free(table_reclaimer_t* reclaimer);
+
+/**
+ * Performs a bounded amount of queued destruction on the calling thread.
+ * Safe to call concurrently with a background thread and with operations on the tables using the reclaimer.
+ * @param reclaimer A pointer to an initialized reclaimer.
+ * @param budget The maximum number of entries to destroy.
+ * @return The number of entries still awaiting destruction.
+ */
+size_t table_reclaim_step(table_reclaimer_t* reclaimer, size_t budget);
+
+#ifdef TABLE_STATS
+
+/**
+ * Reads the instrumentation counters of the given table.
+ * @param table A pointer to an initialized table.
+ * @param out A pointer to the structure receiving the counters.
+ */
+void table_stats(const table_t* table, table_stats_t* out);
+
+/**
+ * Resets the cumulative counters (probe_lengths, resizes, resize_seconds, lookups, and key_compares) of the given
+ *  table.
+ * @param table A pointer to an initialized table.
+ */
+void table_stats_reset(table_t* table);
+
+#endif